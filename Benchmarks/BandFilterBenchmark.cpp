@@ -0,0 +1,108 @@
+// Compares the band filter kernels with the previous CreateGraph loop and the previous bit adjacency build
+#include <random>
+#include <memory>
+#include <StaticVectorLibrary.h>
+#include <BitAdjacency.h>
+#include <BandFilter.h>
+#include <BenchmarkUtil.h>
+
+// Previous CreateGraph followed by a separate BitAdjacency::Build
+template <unsigned int N>
+void FilterBandBaseline(StaticVector<StaticVector<int, N>, N>& source, StaticVector<StaticVector<int, N>, N>& destination,
+	BitAdjacency<N>& adjacency, int low, int high) {
+
+	for (int i = 0; i < N; ++i) {
+		for (int j = 0; j < N; ++j) {
+			int value = source[i][j];
+			destination[i][j] = (value > high || value < low) ? 0 : value;
+		}
+	}
+
+	adjacency.Build(destination);
+}
+
+// Symmetric random distances between 1 and 1500 km, zero on the diagonal
+template <unsigned int N>
+void CreateRandomDistances(StaticVector<StaticVector<int, N>, N>& distances, unsigned int seed) {
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<int> distance(1, 1500);
+
+	for (int i = 0; i < N; ++i) {
+		distances[i][i] = 0;
+		for (int j = i + 1; j < N; ++j) {
+			distances[i][j] = distance(generator);
+			distances[j][i] = distances[i][j];
+		}
+	}
+}
+
+template <unsigned int N>
+bool SameGraph(StaticVector<StaticVector<int, N>, N>& first, BitAdjacency<N>& firstAdjacency,
+	StaticVector<StaticVector<int, N>, N>& second, BitAdjacency<N>& secondAdjacency) {
+
+	for (int i = 0; i < N; ++i) {
+		if (firstAdjacency.Row(i) != secondAdjacency.Row(i))
+			return false;
+		for (int j = 0; j < N; ++j) {
+			if (first[i][j] != second[i][j])
+				return false;
+		}
+	}
+
+	return true;
+}
+
+template <unsigned int N>
+void BenchmarkBandFilter(int repetitions) {
+	typedef StaticVector<StaticVector<int, N>, N> Matrix;
+
+	std::unique_ptr<Matrix> distances(new Matrix());
+	std::unique_ptr<Matrix> expected(new Matrix());
+	std::unique_ptr<Matrix> filtered(new Matrix());
+	std::unique_ptr<BitAdjacency<N>> expectedAdjacency(new BitAdjacency<N>());
+	std::unique_ptr<BitAdjacency<N>> adjacency(new BitAdjacency<N>());
+
+	CreateRandomDistances(*distances, 2024);
+
+	const int low = 200;
+	const int high = 300;
+
+	double baselineNanoseconds = MeasureNanoseconds(repetitions, [&]() {
+		FilterBandBaseline(*distances, *expected, *expectedAdjacency, low, high);
+		benchmarkSink += (*expected)[N - 1][N - 2];
+	});
+
+	PrintBenchmarkHeader(std::to_string(N) + " cities, filter matrix and build bit rows", "baseline", "kernel");
+
+	const BandFilterKernel kernels[3] = { BandFilterKernel::Scalar, BandFilterKernel::SSE2, BandFilterKernel::AVX2 };
+	BandFilterKernel detected = GetBandFilterKernel();
+
+	for (int k = 0; k < 3; ++k) {
+		if (!SetBandFilterKernel(kernels[k])) {
+			std::cout << GetBandFilterKernelName(kernels[k]) << " is not supported by this CPU" << std::endl;
+			continue;
+		}
+
+		double kernelNanoseconds = MeasureNanoseconds(repetitions, [&]() {
+			FilterBand(*distances, *filtered, adjacency.get(), low, high);
+			benchmarkSink += (*filtered)[N - 1][N - 2];
+		});
+
+		PrintBenchmarkRow(GetBandFilterKernelName(kernels[k]), baselineNanoseconds, kernelNanoseconds);
+
+		if (!SameGraph(*expected, *expectedAdjacency, *filtered, *adjacency))
+			std::cout << "RESULTS DIFFER for " << GetBandFilterKernelName(kernels[k]) << std::endl;
+	}
+
+	SetBandFilterKernel(detected);
+}
+
+int main() {
+	std::cout << "Detected kernel is " << GetBandFilterKernelName(GetBandFilterKernel()) << std::endl;
+
+	BenchmarkBandFilter<81>(20000);
+	BenchmarkBandFilter<1000>(50);
+	BenchmarkBandFilter<4000>(5);
+
+	return 0;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+// Sink for benchmark results so the compiler can't remove the measured work
+static volatile long long benchmarkSink = 0;
+
+// Measures the wall clock time of a code block in nanoseconds
+class BenchmarkTimer {
+public:
+	BenchmarkTimer() : start(std::chrono::steady_clock::now()) {
+	}
+
+	void Restart() {
+		start = std::chrono::steady_clock::now();
+	}
+
+	double ElapsedNanoseconds() const {
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	double ElapsedMilliseconds() const {
+		return ElapsedNanoseconds() / 1e6;
+	}
+
+private:
+	std::chrono::steady_clock::time_point start;
+};
+
+// Runs the function repetitions times and returns the mean time of one repetition in nanoseconds
+template <class Function>
+double MeasureNanoseconds(int repetitions, Function function) {
+	function(); // Warm up
+
+	BenchmarkTimer timer;
+	for (int i = 0; i < repetitions; ++i)
+		function();
+
+	return timer.ElapsedNanoseconds() / repetitions;
+}
+
+inline void PrintBenchmarkRow(const std::string& name, double baselineNanoseconds, double newNanoseconds) {
+	std::cout << std::left << std::setw(40) << name
+		<< std::right << std::setw(14) << std::fixed << std::setprecision(1) << baselineNanoseconds
+		<< std::setw(14) << newNanoseconds
+		<< std::setw(10) << std::setprecision(2) << baselineNanoseconds / newNanoseconds << "x" << std::endl;
+}
+
+inline void PrintBenchmarkHeader(const std::string& title, const std::string& baselineName, const std::string& newName) {
+	std::cout << std::endl << title << std::endl;
+	std::cout << std::left << std::setw(40) << "case (ns per repetition)"
+		<< std::right << std::setw(14) << baselineName << std::setw(14) << newName << std::setw(11) << "speedup" << std::endl;
+}
@@ -0,0 +1,115 @@
+// Compares the BFS queues: the LinkedList FIFO the searches used against StaticRingQueue, and the queue
+// based search against the level by level FrontierBfs on the same bit rows
+#include <memory>
+#include <LinkedListLibrary.h>
+#include <StaticRingQueue.h>
+#include <FrontierBfs.h>
+#include <BitAdjacency.h>
+#include <RandomGenerator.h>
+#include <BenchmarkUtil.h>
+
+// Random graph where every pair is an edge with the given probability
+template <unsigned int N>
+void BuildRandomGraph(BitAdjacency<N>& graph, double density, uint64_t seed) {
+	RandomGenerator random(seed);
+
+	for (int i = 0; i < N; ++i) {
+		for (int j = i + 1; j < N; ++j) {
+			if (random.NextDouble() < density)
+				graph.AddEdge(i, j);
+		}
+	}
+}
+
+// BFS with the LinkedList queue, popping the front with Erase like the searches did
+template <unsigned int N>
+int LinkedListBfs(const BitAdjacency<N>& graph, int source, int levels[N]) {
+	LinkedList<int, N> queue;
+
+	for (int i = 0; i < N; ++i)
+		levels[i] = -1;
+
+	levels[source] = 0;
+	queue.PushBack(source);
+
+	int deepest = 0;
+	while (queue.GetSize() != 0) {
+		int city = queue.Front();
+		LinkedListIterator<int, N> front = queue.GetIterator();
+		queue.Erase(front);
+
+		const StaticBitset<N>& row = graph.Row(city);
+		for (int neighbor = row.FindFirst(); neighbor != -1; neighbor = row.FindNext(neighbor)) {
+			if (levels[neighbor] == -1) {
+				levels[neighbor] = deepest = levels[city] + 1;
+				queue.PushBack(neighbor);
+			}
+		}
+	}
+
+	return deepest;
+}
+
+template <unsigned int N>
+int RingQueueBfs(const BitAdjacency<N>& graph, int source, int levels[N]) {
+	StaticRingQueue<int, N> queue;
+
+	for (int i = 0; i < N; ++i)
+		levels[i] = -1;
+
+	levels[source] = 0;
+	queue.Push(source);
+
+	int deepest = 0;
+	while (!queue.IsEmpty()) {
+		int city = queue.Front();
+		queue.Pop();
+
+		const StaticBitset<N>& row = graph.Row(city);
+		for (int neighbor = row.FindFirst(); neighbor != -1; neighbor = row.FindNext(neighbor)) {
+			if (levels[neighbor] == -1) {
+				levels[neighbor] = deepest = levels[city] + 1;
+				queue.Push(neighbor);
+			}
+		}
+	}
+
+	return deepest;
+}
+
+// Runs a BFS from every city, the sum of the depths goes to the sink
+template <unsigned int N, class Search>
+void AllSources(const BitAdjacency<N>& graph, Search search) {
+	int levels[N];
+
+	for (int source = 0; source < N; ++source)
+		benchmarkSink += search(graph, source, levels);
+}
+
+template <unsigned int N>
+void RunBfsBenchmarks(double density, int repetitions) {
+	std::unique_ptr<BitAdjacency<N>> graph(new BitAdjacency<N>());
+	BuildRandomGraph(*graph, density, 7);
+
+	std::string suffix = " N=" + std::to_string(N) + " p=" + std::to_string(density).substr(0, 4);
+
+	double linkedList = MeasureNanoseconds(repetitions, [&]() { AllSources<N>(*graph, LinkedListBfs<N>); });
+	double ringQueue = MeasureNanoseconds(repetitions, [&]() { AllSources<N>(*graph, RingQueueBfs<N>); });
+	PrintBenchmarkRow("linked list -> ring queue" + suffix, linkedList, ringQueue);
+
+	double frontier = MeasureNanoseconds(repetitions, [&]() { AllSources<N>(*graph, FrontierBfs<N, BitAdjacency<N>>); });
+	PrintBenchmarkRow("ring queue -> frontier" + suffix, ringQueue, frontier);
+}
+
+int main() {
+	PrintBenchmarkHeader("BFS from every city", "before", "after");
+
+	RunBfsBenchmarks<81>(0.1, 200);
+	RunBfsBenchmarks<81>(0.4, 200);
+	RunBfsBenchmarks<256>(0.05, 20);
+	RunBfsBenchmarks<256>(0.3, 20);
+	RunBfsBenchmarks<1024>(0.01, 2);
+	RunBfsBenchmarks<1024>(0.1, 2);
+
+	return 0;
+}
@@ -0,0 +1,234 @@
+// Compares the memory mapped CSV loader with the previous getline and istringstream reader on generated tables,
+// and the binary graph cache with the CSV loader
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <memory>
+#include <string>
+#include <vector>
+#include <CsvDistanceLoader.h>
+#include <GraphCache.h>
+#include <WorkStealingThreadPool.h>
+#include <RuntimeSolver.cpp>
+#include <BenchmarkUtil.h>
+
+// Previous reader of RuntimeSolver.cpp
+bool ReadDistanceTableBaseline(const std::string& fileName, std::vector<std::string>& names, std::vector<std::vector<int>>& rows) {
+	std::ifstream file(fileName, std::ios::in | std::ios::binary);
+
+	if (!file.is_open())
+		return false;
+
+	std::string line;
+	std::getline(file, line);
+	std::getline(file, line);
+	while (std::getline(file, line)) {
+		std::istringstream iss(line);
+		std::string token;
+		std::getline(iss, token, ';'); // city plate
+
+		std::getline(iss, token, ';'); // city name
+		if (token.empty())
+			continue;
+		names.push_back(token);
+
+		rows.push_back(std::vector<int>());
+		while (std::getline(iss, token, ';')) {
+			int value = 0;
+			std::istringstream(token) >> value;
+			rows.back().push_back(value);
+		}
+	}
+
+	return true;
+}
+
+// Same layout as ilmesafe.csv: a Windows-1254 title, a header row, the cities and a few separator rows
+void WriteRandomTable(const std::string& fileName, int cityCount, unsigned int seed) {
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<int> distance(1, 1500);
+	std::vector<int> distances(static_cast<size_t>(cityCount) * cityCount, 0);
+
+	for (int i = 0; i < cityCount; ++i) {
+		for (int j = i + 1; j < cityCount; ++j) {
+			distances[static_cast<size_t>(i) * cityCount + j] = distance(generator);
+			distances[static_cast<size_t>(j) * cityCount + i] = distances[static_cast<size_t>(i) * cityCount + j];
+		}
+	}
+
+	std::ofstream file(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+	file << "\xDDL\xDD\x20MESAFELER\xDD;;;\r\n";
+	file << "PLAKA;\xDDL ADI";
+	for (int j = 0; j < cityCount; ++j)
+		file << ';' << j + 1;
+	file << "\r\n";
+
+	for (int i = 0; i < cityCount; ++i) {
+		file << i + 1 << ";CITY" << i + 1;
+		for (int j = 0; j < cityCount; ++j)
+			file << ';' << distances[static_cast<size_t>(i) * cityCount + j];
+		file << "\r\n";
+	}
+
+	for (int i = 0; i < 3; ++i)
+		file << std::string(cityCount + 1, ';') << "\r\n";
+}
+
+bool SameTable(RuntimeGraph& graph, std::vector<std::string>& names, std::vector<std::vector<int>>& rows) {
+	if (graph.GetCityCount() != static_cast<int>(rows.size()))
+		return false;
+
+	for (int i = 0; i < graph.GetCityCount(); ++i) {
+		if (graph.GetNames()[i] != names[i])
+			return false;
+		for (int j = 0; j < graph.GetCityCount(); ++j) {
+			if (graph.Distance(i, j) != rows[i][j])
+				return false;
+		}
+	}
+
+	return true;
+}
+
+bool SameTable(RuntimeGraph& first, RuntimeGraph& second) {
+	if (first.GetCityCount() != second.GetCityCount())
+		return false;
+
+	for (int i = 0; i < first.GetCityCount(); ++i) {
+		if (first.GetNames()[i] != second.GetNames()[i])
+			return false;
+		for (int j = 0; j < first.GetCityCount(); ++j) {
+			if (first.Distance(i, j) != second.Distance(i, j))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+// The baseline keeps every row in its own vector, it is only run while that fits the memory comfortably
+void BenchmarkCsvLoader(int cityCount, int repetitions, bool runBaseline, WorkStealingThreadPool& threadPool) {
+	std::string fileName = "CsvLoaderBenchmark_" + std::to_string(cityCount) + ".csv";
+	WriteRandomTable(fileName, cityCount, 2024);
+
+	PrintBenchmarkHeader(std::to_string(cityCount) + " cities, load distance table", "baseline", "loader");
+
+	std::unique_ptr<RuntimeGraph> single;
+	std::unique_ptr<RuntimeGraph> pooled;
+	CsvDistanceLoader singleLoader;
+	CsvDistanceLoader pooledLoader(&threadPool);
+
+	double singleNanoseconds = MeasureNanoseconds(repetitions, [&]() {
+		CsvLoadResult result = singleLoader.Load(fileName, single);
+		benchmarkSink += result.cityCount;
+	});
+
+	double pooledNanoseconds = MeasureNanoseconds(repetitions, [&]() {
+		CsvLoadResult result = pooledLoader.Load(fileName, pooled);
+		benchmarkSink += result.cityCount;
+	});
+
+	if (runBaseline) {
+		std::vector<std::string> names;
+		std::vector<std::vector<int>> rows;
+
+		double baselineNanoseconds = MeasureNanoseconds(repetitions, [&]() {
+			names.clear();
+			rows.clear();
+			ReadDistanceTableBaseline(fileName, names, rows);
+			benchmarkSink += rows.size();
+		});
+
+		PrintBenchmarkRow("mapped, 1 thread", baselineNanoseconds, singleNanoseconds);
+		PrintBenchmarkRow("mapped, " + std::to_string(threadPool.GetThreadCount()) + " threads", baselineNanoseconds, pooledNanoseconds);
+
+		if (!SameTable(*single, names, rows))
+			std::cout << "RESULTS DIFFER from the baseline" << std::endl;
+	}
+	else
+		PrintBenchmarkRow("mapped, " + std::to_string(threadPool.GetThreadCount()) + " threads vs 1 thread", singleNanoseconds, pooledNanoseconds);
+
+	if (!SameTable(*single, *pooled))
+		std::cout << "RESULTS DIFFER between 1 and " << threadPool.GetThreadCount() << " threads" << std::endl;
+
+	// Startup with the band the solvers use, parse and filter against ReadDistanceTableCached. The first call
+	// writes the cache, the next ones find the stamp of the CSV in it and don't read the CSV.
+	std::string cacheFileName = "CsvLoaderBenchmark_" + std::to_string(cityCount) + ".graph";
+	std::vector<GraphCacheBand> bands(1, GraphCacheBand{ 200, 300 });
+	std::remove(cacheFileName.c_str());
+
+	std::unique_ptr<RuntimeGraph> cached;
+
+	double parseNanoseconds = MeasureNanoseconds(repetitions, [&]() {
+		ReadDistanceTable(fileName, pooled, &threadPool);
+		pooled->FilterBand(200, 300);
+		benchmarkSink += pooled->GetCityCount();
+	});
+
+	double cacheNanoseconds = MeasureNanoseconds(repetitions, [&]() {
+		GraphCache cache;
+		ReadDistanceTableCached(fileName, cacheFileName, cached, cache, bands, &threadPool);
+		cache.LoadBand(*cached, 200, 300);
+		benchmarkSink += cached->GetCityCount();
+	});
+
+	// A cache with another stamp makes ReadDistanceTableCached hash the CSV and write the cache again
+	FileStamp staleStamp;
+	double hashNanoseconds = 0;
+	for (int i = 0; i < repetitions; ++i) {
+		GraphCache::Write(cacheFileName, *cached, 0, staleStamp, bands);
+		GraphCache cache;
+
+		BenchmarkTimer timer;
+		ReadDistanceTableCached(fileName, cacheFileName, cached, cache, bands, &threadPool);
+		cache.LoadBand(*cached, 200, 300);
+		hashNanoseconds += timer.ElapsedNanoseconds() / repetitions;
+	}
+
+	MappedFile source;
+	source.Open(fileName);
+	uint64_t sourceHash = HashBytes(source.GetData(), source.GetSize());
+	source.Close();
+
+	double rehashNanoseconds = 0;
+	for (int i = 0; i < repetitions; ++i) {
+		GraphCache::Write(cacheFileName, *cached, sourceHash, staleStamp, bands);
+		GraphCache cache;
+
+		BenchmarkTimer timer;
+		ReadDistanceTableCached(fileName, cacheFileName, cached, cache, bands, &threadPool);
+		cache.LoadBand(*cached, 200, 300);
+		rehashNanoseconds += timer.ElapsedNanoseconds() / repetitions;
+	}
+
+	PrintBenchmarkHeader(std::to_string(cityCount) + " cities, load and filter 200-300 km", "csv", "cache");
+	PrintBenchmarkRow("cache, same stamp", parseNanoseconds, cacheNanoseconds);
+	PrintBenchmarkRow("cache, other stamp, same CSV", parseNanoseconds, rehashNanoseconds);
+	PrintBenchmarkRow("cache of another CSV", parseNanoseconds, hashNanoseconds);
+
+	if (!SameTable(*pooled, *cached))
+		std::cout << "RESULTS DIFFER between the CSV and the cache" << std::endl;
+	for (int i = 0; i < cityCount; ++i) {
+		for (int j = 0; j < cityCount; ++j) {
+			if (pooled->Edge(i, j) != cached->Edge(i, j)) {
+				std::cout << "BANDS DIFFER between the CSV and the cache" << std::endl;
+				i = cityCount;
+				break;
+			}
+		}
+	}
+
+	std::remove(fileName.c_str());
+	std::remove(cacheFileName.c_str());
+}
+
+int main() {
+	WorkStealingThreadPool threadPool;
+
+	BenchmarkCsvLoader(1000, 5, true, threadPool);
+	BenchmarkCsvLoader(5000, 2, true, threadPool);
+	BenchmarkCsvLoader(10000, 1, false, threadPool);
+
+	return 0;
+}
@@ -0,0 +1,157 @@
+// Convergence of the genetic algorithm operators: best path length found against the number of evaluations,
+// for the position by position Mate and for edge recombination, with and without RepairGnome, and for the
+// parent selections. An evaluation is a gnome made or a move tried by the local search on the elites.
+#include <memory>
+#include <string>
+#include <vector>
+#include <CsvDistanceLoader.h>
+#include <GeneticAlgorithm.cpp>
+#include <BenchmarkUtil.h>
+
+#define BENCHMARK_SEED_COUNT 5
+#define BENCHMARK_GENERATIONS 500
+#define BENCHMARK_CASE_COUNT 6
+
+struct OperatorCase {
+	const char* name;
+	int crossover;
+	bool repair;
+	int selection;
+	bool improveElites;
+};
+
+// Reads ilmesafe.csv into the fixed size matrix the genetic algorithm works on
+bool LoadCityDistances(const std::string& fileName, StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& cityDistances) {
+	std::unique_ptr<RuntimeGraph> table;
+	CsvDistanceLoader loader;
+
+	if (!loader.Load(fileName, table).success || table->GetCityCount() < CITY_COUNT)
+		return false;
+
+	for (int i = 0; i < CITY_COUNT; ++i) {
+		for (int j = 0; j < CITY_COUNT; ++j)
+			cityDistances[i][j] = table->Distance(i, j);
+	}
+
+	return true;
+}
+
+// Evolves one island per seed. bestFitness[i] is the mean over the seeds of the best fitness after the last
+// generation which fits in budgets[i] evaluations, finalFitness, evaluations and milliseconds are the means of a whole run.
+void RunOperatorCase(const BitAdjacency<CITY_COUNT>& band, const OperatorCase& operatorCase, const std::vector<long long>& budgets,
+	std::vector<double>& bestFitness, double& finalFitness, double& evaluations, double& milliseconds) {
+
+	GeneticAlgorithmConfig config;
+	config.islandCount = 1;
+	config.crossover = operatorCase.crossover;
+	config.repair = operatorCase.repair;
+	config.selection = operatorCase.selection;
+	config.improveElites = operatorCase.improveElites;
+
+	bestFitness.assign(budgets.size(), 0.0);
+	finalFitness = 0;
+	evaluations = 0;
+	BenchmarkTimer timer;
+
+	for (int seed = 1; seed <= BENCHMARK_SEED_COUNT; ++seed) {
+		std::unique_ptr<GeneticIsland<int, CITY_COUNT>> island(new GeneticIsland<int, CITY_COUNT>(config.populationSize));
+		island->random.Seed(seed);
+		island->best.fitnessScore = -1;
+
+		InitializeIsland(*island, band, config);
+
+		size_t budget = 0;
+		int fitness = island->best.fitnessScore;
+		for (int generation = 1; generation <= BENCHMARK_GENERATIONS; ++generation) {
+			EvolveIsland(*island, band, config);
+
+			for (; budget < budgets.size() && island->evaluations > budgets[budget]; ++budget)
+				bestFitness[budget] += fitness; // The generation went over the budget, the previous one counts
+			fitness = island->best.fitnessScore;
+		}
+
+		for (; budget < budgets.size(); ++budget)
+			bestFitness[budget] += fitness;
+
+		finalFitness += fitness;
+		evaluations += static_cast<double>(island->evaluations);
+		benchmarkSink += island->best.fitnessScore;
+	}
+
+	for (size_t i = 0; i < bestFitness.size(); ++i)
+		bestFitness[i] /= BENCHMARK_SEED_COUNT;
+
+	finalFitness /= BENCHMARK_SEED_COUNT;
+	evaluations /= BENCHMARK_SEED_COUNT;
+	milliseconds = timer.ElapsedMilliseconds() / BENCHMARK_SEED_COUNT;
+}
+
+void BenchmarkOperators(const std::string& fileName) {
+	std::unique_ptr<StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>> cityDistances(new StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>());
+
+	if (!LoadCityDistances(fileName, *cityDistances)) {
+		std::cout << fileName << " can't be read" << std::endl;
+		return;
+	}
+
+	std::unique_ptr<BitAdjacency<CITY_COUNT>> band(new BitAdjacency<CITY_COUNT>());
+	BuildBandAdjacency(*cityDistances, *band, DISTANCE - TOLERANCE, DISTANCE + TOLERANCE);
+
+	const OperatorCase cases[BENCHMARK_CASE_COUNT] = {
+		{ "Mate", CROSSOVER_UNIFORM, false, SELECTION_UNIFORM, false },
+		{ "Mate+repair", CROSSOVER_UNIFORM, true, SELECTION_UNIFORM, false },
+		{ "Edge+repair", CROSSOVER_EDGE_RECOMBINATION, true, SELECTION_UNIFORM, false },
+		{ "tournament", CROSSOVER_EDGE_RECOMBINATION, true, SELECTION_TOURNAMENT, false },
+		{ "roulette", CROSSOVER_EDGE_RECOMBINATION, true, SELECTION_ROULETTE, false },
+		{ "roulette+SA", CROSSOVER_EDGE_RECOMBINATION, true, SELECTION_ROULETTE, true }
+	};
+
+	// The cases without local search make a child per gnome which isn't an elite, about 50k in the whole run
+	const long long checkpoints[] = { 100, 500, 1000, 2500, 5000, 10000, 25000, 50000 };
+	std::vector<long long> budgets(checkpoints, checkpoints + sizeof(checkpoints) / sizeof(checkpoints[0]));
+
+	std::vector<double> bestFitness[BENCHMARK_CASE_COUNT];
+	double finalFitness[BENCHMARK_CASE_COUNT];
+	double evaluations[BENCHMARK_CASE_COUNT];
+	double milliseconds[BENCHMARK_CASE_COUNT];
+
+	for (int i = 0; i < BENCHMARK_CASE_COUNT; ++i)
+		RunOperatorCase(*band, cases[i], budgets, bestFitness[i], finalFitness[i], evaluations[i], milliseconds[i]);
+
+	std::cout << std::endl << CITY_COUNT << " cities, " << DISTANCE << "/" << TOLERANCE << " band, population " << POPULATION_SIZE
+		<< ", mean best fitness of " << BENCHMARK_SEED_COUNT << " seeds" << std::endl;
+	std::cout << "Uniform parent selection up to Edge+repair, the selections after it use edge recombination and repair,"
+		<< " SA anneals the elite every generation and its moves count as evaluations" << std::endl;
+	std::cout << std::left << std::setw(14) << "evaluations";
+	for (int i = 0; i < BENCHMARK_CASE_COUNT; ++i)
+		std::cout << std::right << std::setw(14) << cases[i].name;
+	std::cout << std::endl;
+
+	for (size_t c = 0; c < budgets.size(); ++c) {
+		std::cout << std::left << std::setw(14) << budgets[c];
+		for (int i = 0; i < BENCHMARK_CASE_COUNT; ++i)
+			std::cout << std::right << std::setw(14) << std::fixed << std::setprecision(1) << bestFitness[i][c];
+		std::cout << std::endl;
+	}
+
+	std::cout << std::left << std::setw(14) << "end of run";
+	for (int i = 0; i < BENCHMARK_CASE_COUNT; ++i)
+		std::cout << std::right << std::setw(14) << std::fixed << std::setprecision(1) << finalFitness[i];
+	std::cout << std::endl;
+
+	std::cout << std::left << std::setw(14) << "evals per run";
+	for (int i = 0; i < BENCHMARK_CASE_COUNT; ++i)
+		std::cout << std::right << std::setw(14) << std::fixed << std::setprecision(0) << evaluations[i];
+	std::cout << std::endl;
+
+	std::cout << std::left << std::setw(14) << "ms per run";
+	for (int i = 0; i < BENCHMARK_CASE_COUNT; ++i)
+		std::cout << std::right << std::setw(14) << std::fixed << std::setprecision(1) << milliseconds[i];
+	std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+	BenchmarkOperators(argc > 1 ? argv[1] : "ilmesafe.csv");
+
+	return 0;
+}
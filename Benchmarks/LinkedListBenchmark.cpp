@@ -0,0 +1,133 @@
+// Compares the doubly linked LinkedList with the previous singly linked one, where PopBack and stepping back
+// with the iterator walked from the first node
+#include <memory>
+#include <LinkedListLibrary.h>
+#include <BenchmarkUtil.h>
+
+// Previous LinkedList operations on nodes which only know the next node
+template <class T, unsigned int N>
+class SinglyLinkedList {
+public:
+	struct SinglyNode {
+		T data;
+		SinglyNode* next;
+	};
+
+	SinglyLinkedList() : first(NULL), last(NULL), size(0) {
+	}
+
+	bool PushBack(const T& element) {
+		SinglyNode* node = pool.Allocate();
+		if (node == NULL)
+			return false;
+
+		node->data = element;
+		node->next = NULL;
+		if (first == NULL)
+			first = node;
+		else
+			last->next = node;
+		last = node;
+		size++;
+		return true;
+	}
+
+	// Walks to the node before the last one
+	bool PopBack() {
+		if (first == NULL)
+			return false;
+
+		if (first->next == NULL) {
+			pool.Free(first);
+			first = last = NULL;
+		}
+		else {
+			SinglyNode* temp = first;
+			while (temp->next->next != NULL)
+				temp = temp->next;
+
+			pool.Free(temp->next);
+			temp->next = NULL;
+			last = temp;
+		}
+
+		size--;
+		return true;
+	}
+
+	// Visits the elements from the last one, every step walks from the first node like Prev did
+	long long SumBackward() {
+		long long sum = 0;
+		SinglyNode* current = NULL;
+
+		while (current != first) {
+			SinglyNode* temp = first;
+			while (temp->next != current)
+				temp = temp->next;
+
+			sum += temp->data;
+			current = temp;
+		}
+
+		return sum;
+	}
+
+private:
+	ObjectPool<SinglyNode, N> pool;
+	SinglyNode* first;
+	SinglyNode* last;
+	int size;
+};
+
+template <unsigned int N>
+long long SumBackward(LinkedList<int, N>& list) {
+	LinkedListIterator<int, N> iterator = list.GetIterator();
+	while (iterator.HasNext())
+		iterator.Next();
+
+	long long sum = 0;
+	while (iterator.HasPrev())
+		sum += iterator.Prev();
+
+	return sum;
+}
+
+template <class List, unsigned int N>
+void FillAndPopBack(List& list) {
+	for (int i = 0; i < N; ++i)
+		list.PushBack(i);
+
+	while (list.PopBack())
+		benchmarkSink++;
+}
+
+template <unsigned int N>
+void RunLinkedListBenchmarks(int repetitions) {
+	std::unique_ptr<SinglyLinkedList<int, N>> singly(new SinglyLinkedList<int, N>());
+	std::unique_ptr<LinkedList<int, N>> doubly(new LinkedList<int, N>());
+
+	std::string suffix = " N=" + std::to_string(N);
+
+	double before = MeasureNanoseconds(repetitions, [&]() { FillAndPopBack<SinglyLinkedList<int, N>, N>(*singly); });
+	double after = MeasureNanoseconds(repetitions, [&]() { FillAndPopBack<LinkedList<int, N>, N>(*doubly); });
+	PrintBenchmarkRow("fill and pop back" + suffix, before, after);
+
+	for (int i = 0; i < N; ++i) {
+		singly->PushBack(i);
+		doubly->PushBack(i);
+	}
+
+	before = MeasureNanoseconds(repetitions, [&]() { benchmarkSink += singly->SumBackward(); });
+	after = MeasureNanoseconds(repetitions, [&]() { benchmarkSink += SumBackward<N>(*doubly); });
+	PrintBenchmarkRow("backward iteration" + suffix, before, after);
+}
+
+int main() {
+	PrintBenchmarkHeader("LinkedList PopBack/Prev", "singly", "doubly");
+
+	RunLinkedListBenchmarks<81>(20000);
+	RunLinkedListBenchmarks<256>(2000);
+	RunLinkedListBenchmarks<1024>(100);
+
+	return 0;
+}
@@ -0,0 +1,109 @@
+// Compares the free-list ObjectPool with the previous linear scanning pool
+#include <LinkedListLibrary.h>
+#include <BenchmarkUtil.h>
+
+// Previous ObjectPool implementation, Allocate and Free scan the whole pool
+template <class T, unsigned int N>
+class ScanningObjectPool {
+private:
+	T pool[N];
+	int poolAvailability[N];
+	int usedObjects;
+
+public:
+	ScanningObjectPool() : usedObjects(0) {
+		for (int i = 0; i < N; i++)
+			poolAvailability[i] = AVAILABLE;
+	}
+
+	T* Allocate() {
+		for (int i = 0; i < N; i++) {
+			if (poolAvailability[i] == AVAILABLE) {
+				usedObjects++;
+				poolAvailability[i] = OCCUPIED;
+				return &pool[i];
+			}
+		}
+		return NULL;
+	}
+
+	bool Free(T* freedObject) {
+		for (int i = 0; i < N; i++) {
+			if (freedObject == &pool[i]) {
+				poolAvailability[i] = AVAILABLE;
+				usedObjects--;
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+// Fills the pool then frees every object in allocation order
+template <class Pool, class T, unsigned int N>
+void FillAndDrain(Pool& pool) {
+	T* objects[N];
+
+	for (int i = 0; i < N; ++i)
+		objects[i] = pool.Allocate();
+
+	for (int i = 0; i < N; ++i)
+		benchmarkSink += pool.Free(objects[i]);
+}
+
+// Access pattern of a BFS queue built on LinkedList, push to back and pop from front
+template <class Pool, class T, unsigned int N>
+void QueuePattern(Pool& pool) {
+	T* queue[N];
+	int head = 0;
+	int tail = 0;
+	int count = 0;
+
+	for (int step = 0; step < 4 * N; ++step) {
+		if (count < N / 2 || (step & 1)) {
+			T* object = pool.Allocate();
+			if (object != NULL) {
+				queue[tail] = object;
+				tail = (tail + 1) % N;
+				count++;
+			}
+		}
+		else {
+			pool.Free(queue[head]);
+			head = (head + 1) % N;
+			count--;
+		}
+	}
+
+	while (count > 0) {
+		pool.Free(queue[head]);
+		head = (head + 1) % N;
+		count--;
+	}
+}
+
+template <unsigned int N>
+void RunPoolBenchmarks(int repetitions) {
+	ScanningObjectPool<Node<int>, N> scanningPool;
+	ObjectPool<Node<int>, N> freeListPool;
+
+	std::string suffix = " N=" + std::to_string(N);
+
+	double scanning = MeasureNanoseconds(repetitions, [&]() { FillAndDrain<ScanningObjectPool<Node<int>, N>, Node<int>, N>(scanningPool); });
+	double freeList = MeasureNanoseconds(repetitions, [&]() { FillAndDrain<ObjectPool<Node<int>, N>, Node<int>, N>(freeListPool); });
+	PrintBenchmarkRow("fill and drain" + suffix, scanning, freeList);
+
+	scanning = MeasureNanoseconds(repetitions, [&]() { QueuePattern<ScanningObjectPool<Node<int>, N>, Node<int>, N>(scanningPool); });
+	freeList = MeasureNanoseconds(repetitions, [&]() { QueuePattern<ObjectPool<Node<int>, N>, Node<int>, N>(freeListPool); });
+	PrintBenchmarkRow("bfs queue pattern" + suffix, scanning, freeList);
+}
+
+int main() {
+	PrintBenchmarkHeader("ObjectPool Allocate/Free", "scanning", "free-list");
+
+	RunPoolBenchmarks<81>(20000);
+	RunPoolBenchmarks<256>(5000);
+	RunPoolBenchmarks<1024>(500);
+
+	return 0;
+}
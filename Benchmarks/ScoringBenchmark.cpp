@@ -0,0 +1,198 @@
+// Compares the virtual algorithm combination with the compile time ScoreComposer
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <cmath>
+#include <memory>
+#include <HeuristicApproaches.cpp>
+#include <ScoreComposer.h>
+#include <BenchmarkUtil.h>
+
+#define BENCHMARK_DISTANCE 250
+#define BENCHMARK_TOLERANCE 50
+
+// Reads the distance matrix of ilmesafe.csv, same format as readCSVFile of MyProjectMain
+bool LoadCityDistances(const std::string& fileName, StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& cityDistances) {
+	std::ifstream file(fileName, std::ios::in | std::ios::binary);
+
+	if (!file.is_open())
+		return false;
+
+	std::string line;
+	std::getline(file, line);
+	std::getline(file, line);
+
+	int i = 0;
+	while (i < CITY_COUNT && std::getline(file, line)) {
+		std::istringstream iss(line);
+		std::string token;
+		std::getline(iss, token, ';'); // city plate
+		std::getline(iss, token, ';'); // city name
+
+		int j = 0;
+		while (j < CITY_COUNT && std::getline(iss, token, ';')) {
+			int value = 0;
+			std::istringstream(token) >> value;
+			cityDistances[i][j] = value;
+			j++;
+		}
+		i++;
+	}
+
+	return i == CITY_COUNT;
+}
+
+// Greedy search from every city with both versions, the found path lengths have to be the same
+void BenchmarkCityDataset(const std::string& fileName) {
+	std::unique_ptr<StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>> cityDistances(new StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>());
+	std::unique_ptr<StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>> graph(new StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>());
+
+	if (!LoadCityDistances(fileName, *cityDistances)) {
+		std::cout << fileName << " can't be read, skipping the city dataset" << std::endl;
+		return;
+	}
+
+	CreateGraph(*cityDistances, BENCHMARK_DISTANCE, BENCHMARK_TOLERANCE);
+
+	FirstOrderNeighbors<int, CITY_COUNT> firstOrderNeighbors;
+	SecondOrderNeighbors<int, CITY_COUNT> secondOrderNeighbors;
+	ThirdOrderNeighbors<int, CITY_COUNT> thirdOrderNeighbors;
+	ClosenessCentrality<int, CITY_COUNT> closenessCentrality;
+	Algorithms<int, CITY_COUNT>* algorithms[4] = { &firstOrderNeighbors, &secondOrderNeighbors, &thirdOrderNeighbors, &closenessCentrality };
+	CombinationScorer scorer;
+
+	bool visited[CITY_COUNT];
+	int virtualTotal = 0;
+	int composedTotal = 0;
+
+	auto resetSearch = [&]() {
+		for (int i = 0; i < CITY_COUNT; ++i) {
+			visited[i] = false;
+			for (int j = 0; j < CITY_COUNT; ++j)
+				(*graph)[i][j] = (*cityDistances)[i][j];
+		}
+	};
+
+	double virtualNanoseconds = MeasureNanoseconds(5, [&]() {
+		virtualTotal = 0;
+		for (int city = 0; city < CITY_COUNT; ++city) {
+			resetSearch();
+			virtualTotal += FindLongestPathCombination(*graph, visited, city, -1, algorithms, NULL);
+		}
+		benchmarkSink += virtualTotal;
+	});
+
+	double composedNanoseconds = MeasureNanoseconds(5, [&]() {
+		composedTotal = 0;
+		for (int city = 0; city < CITY_COUNT; ++city) {
+			resetSearch();
+			composedTotal += FindLongestPathComposed(*graph, visited, city, -1, scorer);
+		}
+		benchmarkSink += composedTotal;
+	});
+
+	PrintBenchmarkHeader("81 cities, " + std::to_string(BENCHMARK_DISTANCE) + "/" + std::to_string(BENCHMARK_TOLERANCE)
+		+ " band, search from every city", "virtual", "composed");
+	PrintBenchmarkRow("FindLongestPathCombination", virtualNanoseconds, composedNanoseconds);
+
+	if (virtualTotal != composedTotal)
+		std::cout << "RESULTS DIFFER: " << virtualTotal << " and " << composedTotal << std::endl;
+}
+
+// Random cities on a 1500 km square, the graph keeps the pairs in the distance band like CreateGraph
+template <unsigned int N>
+void CreateSyntheticGraph(StaticVector<StaticVector<int, N>, N>& graph, int distance, int tolerance, unsigned int seed) {
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<double> coordinate(0.0, 1500.0);
+	double x[N];
+	double y[N];
+
+	for (int i = 0; i < N; ++i) {
+		x[i] = coordinate(generator);
+		y[i] = coordinate(generator);
+	}
+
+	for (int i = 0; i < N; ++i) {
+		for (int j = 0; j < N; ++j) {
+			int pairDistance = static_cast<int>(std::sqrt((x[i] - x[j]) * (x[i] - x[j]) + (y[i] - y[j]) * (y[i] - y[j])));
+			graph[i][j] = (i != j && pairDistance >= distance - tolerance && pairDistance <= distance + tolerance) ? pairDistance : 0;
+		}
+	}
+}
+
+// Scores every neighbor of every city, the inner loop of the combination search
+template <unsigned int N>
+void BenchmarkSyntheticGraph(int distance, int tolerance) {
+	typedef ScoreComposer<int, N,
+		WeightedTerm<FirstOrderNeighbors<int, N>, -1>,
+		WeightedTerm<SecondOrderNeighbors<int, N>, 1>,
+		WeightedTerm<ThirdOrderNeighbors<int, N>, 1>,
+		WeightedTerm<ClosenessCentrality<int, N>, 1>> SyntheticScorer;
+
+	std::unique_ptr<StaticVector<StaticVector<int, N>, N>> graph(new StaticVector<StaticVector<int, N>, N>());
+	CreateSyntheticGraph(*graph, distance, tolerance, 12345);
+
+	std::unique_ptr<FirstOrderNeighbors<int, N>> firstOrderNeighbors(new FirstOrderNeighbors<int, N>());
+	std::unique_ptr<SecondOrderNeighbors<int, N>> secondOrderNeighbors(new SecondOrderNeighbors<int, N>());
+	std::unique_ptr<ThirdOrderNeighbors<int, N>> thirdOrderNeighbors(new ThirdOrderNeighbors<int, N>());
+	std::unique_ptr<ClosenessCentrality<int, N>> closenessCentrality(new ClosenessCentrality<int, N>());
+	Algorithms<int, N>* algorithms[4] = { firstOrderNeighbors.get(), secondOrderNeighbors.get(), thirdOrderNeighbors.get(), closenessCentrality.get() };
+	std::unique_ptr<SyntheticScorer> scorer(new SyntheticScorer());
+
+	bool visited[N] = { false };
+	StaticBitset<N> visitedBits;
+	int edgeCount = 0;
+
+	for (int i = 0; i < 4; ++i)
+		algorithms[i]->Prepare(*graph);
+	scorer->Prepare(*graph);
+
+	double virtualSum = 0;
+	double composedSum = 0;
+
+	double virtualNanoseconds = MeasureNanoseconds(3, [&]() {
+		virtualSum = 0;
+		edgeCount = 0;
+		for (int city = 0; city < N; ++city) {
+			for (int neighbor = 0; neighbor < N; ++neighbor) {
+				if (!(*graph)[city][neighbor])
+					continue;
+
+				double tempScore = 0;
+				for (int j = 0; j < 4; ++j)
+					tempScore += COMBINATION_WEIGHTS[j] * algorithms[j]->Score(neighbor, *graph, visited);
+				virtualSum += tempScore;
+				edgeCount++;
+			}
+		}
+		benchmarkSink += static_cast<long long>(virtualSum);
+	});
+
+	double composedNanoseconds = MeasureNanoseconds(3, [&]() {
+		composedSum = 0;
+		for (int city = 0; city < N; ++city) {
+			for (int neighbor = 0; neighbor < N; ++neighbor) {
+				if ((*graph)[city][neighbor])
+					composedSum += scorer->Score(neighbor, *graph, visited, visitedBits);
+			}
+		}
+		benchmarkSink += static_cast<long long>(composedSum);
+	});
+
+	PrintBenchmarkHeader(std::to_string(N) + " synthetic cities, " + std::to_string(edgeCount) + " arcs, score every neighbor",
+		"virtual", "composed");
+	PrintBenchmarkRow("combination score", virtualNanoseconds, composedNanoseconds);
+
+	if (virtualSum != composedSum)
+		std::cout << "RESULTS DIFFER: " << virtualSum << " and " << composedSum << std::endl;
+}
+
+int main(int argc, char** argv) {
+	BenchmarkCityDataset(argc > 1 ? argv[1] : "ilmesafe.csv");
+
+	BenchmarkSyntheticGraph<128>(250, 50);
+	BenchmarkSyntheticGraph<256>(250, 30);
+	BenchmarkSyntheticGraph<512>(250, 15);
+
+	return 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <StaticBitsetLibrary.h>
+
+// Breadth first search which expands a whole level at once: the next level is the OR of the neighbor rows of
+// the frontier minus the cities seen before, so there is no queue. A level costs one row OR per frontier city,
+// a row OR works on 64 cities per word. graph.Row(i) has to return the StaticBitset<N> of the neighbors of city i, like BitAdjacency.
+// levels[i] becomes the hop count from source, -1 for the cities it can't reach. Returns the deepest level.
+template <unsigned int N, class Graph>
+int FrontierBfs(const Graph& graph, int source, int levels[N]) {
+	for (int i = 0; i < N; ++i)
+		levels[i] = -1;
+
+	StaticBitset<N> seen;
+	StaticBitset<N> frontier;
+	seen.Set(source);
+	frontier.Set(source);
+	levels[source] = 0;
+
+	int level = 0;
+
+	while (true) {
+		StaticBitset<N> next;
+		for (int i = frontier.FindFirst(); i != -1; i = frontier.FindNext(i))
+			next |= graph.Row(i);
+		next.AndNot(seen);
+
+		if (!next.Any())
+			return level;
+
+		level++;
+		for (int i = next.FindFirst(); i != -1; i = next.FindNext(i))
+			levels[i] = level;
+
+		seen |= next;
+		frontier = next;
+	}
+}
@@ -5,6 +5,7 @@ template <class T, unsigned int N>
 class LinkedListIterator {
 private:
 	Node<T>* first;
+	Node<T>* const* listLast; // Last node pointer of the list, read when Prev steps back from the end
 	Node<T>* currentNode;
 	template<typename U, unsigned int N>
 	friend class LinkedList;
@@ -15,7 +16,13 @@ private:
 
 public:
 	// For general iterator
-	LinkedListIterator(Node<T>* head) : first(head) {
+	LinkedListIterator(Node<T>* head) : first(head), listLast(NULL) {
+		currentNode = head;
+	}
+
+	// Knowing where the list keeps its last node lets Prev step back from the end without walking the list,
+	// nodes pushed after the iterator was made are seen too
+	LinkedListIterator(Node<T>* head, Node<T>* const* tail) : first(head), listLast(tail) {
 		currentNode = head;
 	}
 
@@ -47,10 +54,12 @@ public:
 		if (!HasPrev())
 			return {};
 
-		Node<T>* temp = first;
+		Node<T>* temp = (currentNode != NULL) ? currentNode->prev : (listLast != NULL ? *listLast : NULL);
 
-		while (temp->next != currentNode) {
-			temp = temp->next;
+		if (temp == NULL) { // Past the end of an iterator made without the last node
+			temp = first;
+			while (temp->next != NULL)
+				temp = temp->next;
 		}
 
 		T returnData = temp->data;
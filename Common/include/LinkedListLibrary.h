@@ -4,6 +4,8 @@
 #include <LinkedListIterator.h>
 #include <ObjectPool.h>
 
+// Doubly linked list with its nodes in a fixed size pool. Every node knows its previous node, so PopBack,
+// PopFront, Insert and Erase at an iterator and stepping back with the iterator are O(1).
 template <class T, unsigned int N>
 class LinkedList {
 protected:
@@ -21,6 +23,7 @@ public:
 	void Clear();
 	bool PushBack(const T& element);
 	bool PopBack();
+	bool PopFront();
 	T Front();
 	T Back();
 	int GetSize();
@@ -55,11 +58,13 @@ std::ostream& operator<< (std::ostream& os, LinkedList<T, N>& list) {
 template <class T>
 Node<T>::Node() {
 	this->next = NULL;
+	this->prev = NULL;
 }
 
 template <class T>
 Node<T>::Node(const T data) {
 	this->next = NULL;
+	this->prev = NULL;
 	this->data = data;
 }
 
@@ -82,13 +87,9 @@ int LinkedList<T, N>::GetSize() {
 
 template <class T, unsigned int N>
 void LinkedList<T, N>::Clear() {
-
-	if (first == nullptr)
-		return;
-	
 	Node<T>* temp = first;
 
-	while (temp->next != NULL) {
+	while (temp != NULL) {
 		Node<T>* next = temp->next;
 		nodePool.Free(temp);
 		temp = next;
@@ -101,37 +102,21 @@ void LinkedList<T, N>::Clear() {
 
 template <class T, unsigned int N>
 bool LinkedList<T, N>::PushBack(const T& element) {
-	if (first == NULL) {
+	Node<T>* allocatedNode = nodePool.Allocate();
 
-		Node<T>* allocatedNode = nodePool.Allocate();
-	
-		if (allocatedNode == NULL)
-			return false;
+	if (allocatedNode == NULL)
+		return false;
 
-		allocatedNode->data = element;
-		allocatedNode->next = NULL;
+	allocatedNode->data = element;
+	allocatedNode->next = NULL;
+	allocatedNode->prev = last;
 
+	if (first == NULL)
 		first = allocatedNode;
-
-		last = first;
-		//cout << "Element pushed to first place!" << endl;
-
-	}
-	else {
-
-		Node<T>* allocatedNode = nodePool.Allocate();
-
-		if (allocatedNode == NULL)
-			return false;
-
-		allocatedNode->data = element;
-		allocatedNode->next = NULL;
-
+	else
 		last->next = allocatedNode;
-		//cout << "Element pushed to back of the list " << endl;
-		last = last->next;
-	}
 
+	last = allocatedNode;
 	size++;
 	return true;
 }
@@ -144,26 +129,34 @@ bool LinkedList<T, N>::PopBack() {
 		return false;
 	}
 
-	if (first->next == NULL) {
-		nodePool.Free(first);
+	Node<T>* popped = last;
+	last = popped->prev;
+
+	if (last == NULL)
 		first = NULL;
-		last = NULL;
-	}
+	else
+		last->next = NULL;
 
-	Node<T>* temp = first;
+	nodePool.Free(popped);
+	size--;
+	return true;
+}
 
-	while (temp != NULL) {
-		if (temp->next->next == NULL) {
-			nodePool.Free(temp->next);
-			nodePool.Free(new Node<T>()); // Outside object for testing
-			temp->next = NULL;
-			last = temp;
-			//cout << "last item is popped" << endl;
-			break;
-		}
-		temp = temp->next;
-	}
+template <class T, unsigned int N>
+bool LinkedList<T, N>::PopFront() {
+
+	if (first == NULL)
+		return false;
+
+	Node<T>* popped = first;
+	first = popped->next;
 
+	if (first == NULL)
+		last = NULL;
+	else
+		first->prev = NULL;
+
+	nodePool.Free(popped);
 	size--;
 	return true;
 }
@@ -188,79 +181,62 @@ T LinkedList<T, N>::Back() {
 template <class T, unsigned int N>
 LinkedListIterator<T, N> LinkedList<T, N>::GetIterator()
 {
-	return LinkedListIterator<T, N>(first);
+	return LinkedListIterator<T, N>(first, &last);
 }
 
+// Inserts the element before the node of the iterator, at the end if the iterator is past the last node
 template <class T, unsigned int N>
 bool LinkedList<T, N>::Insert(LinkedListIterator<T, N> pos, const T& element) {
 
-	if (first == pos.currentNode) {
-		Node<T>* allocatedNode = nodePool.Allocate();
-
-		if (allocatedNode == NULL)
-			return false;
-
-		allocatedNode->data = element;
-		allocatedNode->next = NULL;
-
-		first = allocatedNode;
-		first->next = pos.currentNode;
-		
-	}
-	else if (last->next == pos.currentNode) {
-		PushBack(element);
-	}
-	else {
-		Node<T>* temp = pos.currentNode;
-		pos.Prev();
+	if (pos.currentNode == NULL)
+		return PushBack(element);
 
-		Node<T>* allocatedNode = nodePool.Allocate();
+	Node<T>* allocatedNode = nodePool.Allocate();
 
-		if (allocatedNode == NULL)
-			return false;
+	if (allocatedNode == NULL)
+		return false;
 
-		allocatedNode->data = element;
-		allocatedNode->next = NULL;
+	Node<T>* next = pos.currentNode;
+	allocatedNode->data = element;
+	allocatedNode->next = next;
+	allocatedNode->prev = next->prev;
 
-		pos.currentNode->next = allocatedNode;
-		pos.currentNode->next->next = temp;
-	}
+	if (next->prev == NULL)
+		first = allocatedNode;
+	else
+		next->prev->next = allocatedNode;
 
+	next->prev = allocatedNode;
 	size++;
 	return true;
 }
 
+// Removes the node of the iterator. The iterator moves to the next node when the first node is erased and
+// to the previous node otherwise.
 template <class T, unsigned int N>
 bool LinkedList<T, N>::Erase(LinkedListIterator<T, N>& pos) {
 
-	if (pos.currentNode == NULL) {
+	Node<T>* erased = pos.currentNode;
+
+	if (erased == NULL) {
 		//cout << "Can't delete the null node" << endl;
 		return false;
 	}
-	else if (first == pos.currentNode) { // If iterator is at the first element
-		Node<T>* temp = first;
-		first = first->next;
-		nodePool.Free(temp);
-		pos.Next();
-		
-	}
-	else if (last == pos.currentNode) { // If iterator is at the end element
 
-		pos.Prev();
-		last = pos.currentNode;
-		nodePool.Free(last->next);
-			//cout << "Free is successful1" << endl;
-	}
-	else {
-		Node<T>* nextNode = pos.currentNode->next;
-		pos.Prev();
-		
-		nodePool.Free(pos.currentNode->next);
-			//cout << "Free is successful2" << endl;
+	if (erased->prev == NULL)
+		first = erased->next;
+	else
+		erased->prev->next = erased->next;
 
-		pos.currentNode->next = nextNode;
+	if (erased->next == NULL)
+		last = erased->prev;
+	else
+		erased->next->prev = erased->prev;
 
-	}
+	pos.currentNode = (erased->prev == NULL) ? erased->next : erased->prev;
+	pos.first = first;
+
+	nodePool.Free(erased);
 	//cout << "Erase is succesful3" << endl;
 	size--;
 	return true;
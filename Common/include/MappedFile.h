@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Read only memory mapping of a whole file, the pages are read by the OS when they are first touched.
+// An empty file is opened with size 0 and a non NULL data pointer.
+class MappedFile {
+public:
+	MappedFile() : data(NULL), size(0), opened(false) {
+	}
+
+	~MappedFile() {
+		Close();
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const std::string& fileName);
+	void Close();
+
+	bool IsOpen() const { return opened; }
+	const char* GetData() const { return data; }
+	size_t GetSize() const { return size; }
+
+private:
+	const char* data;
+	size_t size;
+	bool opened;
+
+#if defined(_WIN32)
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = NULL;
+#endif
+};
+
+// Size and last write time of a file, read without opening it. Used to notice a changed file without reading it,
+// modified is in the units of the platform and only meant to be compared.
+struct FileStamp {
+	uint64_t size = 0;
+	int64_t modified = 0;
+};
+
+inline bool GetFileStamp(const std::string& fileName, FileStamp& stamp);
+
+#if defined(_WIN32)
+
+inline bool GetFileStamp(const std::string& fileName, FileStamp& stamp) {
+	WIN32_FILE_ATTRIBUTE_DATA attributes;
+	if (!GetFileAttributesExA(fileName.c_str(), GetFileExInfoStandard, &attributes))
+		return false;
+
+	stamp.size = (static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+	stamp.modified = static_cast<int64_t>((static_cast<uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32) |
+		attributes.ftLastWriteTime.dwLowDateTime); // 100 ns units
+	return true;
+}
+
+inline bool MappedFile::Open(const std::string& fileName) {
+	Close();
+
+	file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize)) {
+		Close();
+		return false;
+	}
+
+	size = static_cast<size_t>(fileSize.QuadPart);
+	opened = true;
+
+	if (size == 0) { // Files of size 0 can't be mapped
+		data = "";
+		return true;
+	}
+
+	mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL) {
+		Close();
+		return false;
+	}
+
+	data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (data == NULL) {
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+inline void MappedFile::Close() {
+	if (data != NULL && size != 0)
+		UnmapViewOfFile(data);
+	if (mapping != NULL)
+		CloseHandle(mapping);
+	if (file != INVALID_HANDLE_VALUE)
+		CloseHandle(file);
+
+	data = NULL;
+	size = 0;
+	opened = false;
+	mapping = NULL;
+	file = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+inline bool GetFileStamp(const std::string& fileName, FileStamp& stamp) {
+	struct stat status;
+	if (stat(fileName.c_str(), &status) != 0)
+		return false;
+
+	stamp.size = static_cast<uint64_t>(status.st_size);
+#if defined(__linux__)
+	stamp.modified = static_cast<int64_t>(status.st_mtim.tv_sec) * 1000000000 + status.st_mtim.tv_nsec;
+#elif defined(__APPLE__)
+	stamp.modified = static_cast<int64_t>(status.st_mtimespec.tv_sec) * 1000000000 + status.st_mtimespec.tv_nsec;
+#else
+	stamp.modified = static_cast<int64_t>(status.st_mtime);
+#endif
+	return true;
+}
+
+inline bool MappedFile::Open(const std::string& fileName) {
+	Close();
+
+	int descriptor = open(fileName.c_str(), O_RDONLY);
+	if (descriptor < 0)
+		return false;
+
+	struct stat status;
+	if (fstat(descriptor, &status) != 0) {
+		close(descriptor);
+		return false;
+	}
+
+	size = static_cast<size_t>(status.st_size);
+
+	if (size == 0) { // Files of size 0 can't be mapped
+		close(descriptor);
+		data = "";
+		opened = true;
+		return true;
+	}
+
+	void* mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	close(descriptor); // The mapping keeps the file open
+
+	if (mapped == MAP_FAILED) {
+		size = 0;
+		return false;
+	}
+
+	data = static_cast<const char*>(mapped);
+	opened = true;
+	return true;
+}
+
+inline void MappedFile::Close() {
+	if (data != NULL && size != 0)
+		munmap(const_cast<char*>(data), size);
+
+	data = NULL;
+	size = 0;
+	opened = false;
+}
+
+#endif
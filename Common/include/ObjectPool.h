@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <cstdint>
 
 #define AVAILABLE 1
 #define OCCUPIED 0
@@ -13,6 +14,7 @@ class Node {
 private:
 	T data;
 	Node<T>* next;
+	Node<T>* prev;
 	template<typename U, unsigned int N>
 	friend class LinkedList;
 
@@ -26,11 +28,15 @@ public:
 };
 
 
+// Fixed capacity pool with O(1) Allocate and Free.
+// Free slots are kept in an index stack, ownership of a freed pointer is checked with pointer arithmetic.
 template <class T, unsigned int N>
 class ObjectPool {
 private:
 	T pool[N];
 	int poolAvailability[N];
+	int freeIndices[N]; // Stack of available slot indices, top is freeIndices[freeCount - 1]
+	int freeCount;
 	int usedObjects;
 
 public:
@@ -38,14 +44,17 @@ public:
 	~ObjectPool();
 	T* Allocate();
 	bool Free(T* node);
+	bool Owns(const T* object) const;
+	int GetUsedCount() const;
 
 };
 
 
 template <class T, unsigned int N>
-ObjectPool<T, N>::ObjectPool() : usedObjects(0) { 
+ObjectPool<T, N>::ObjectPool() : freeCount(N), usedObjects(0) {
 	for (int i = 0; i < N; i++) {
 		poolAvailability[i] = AVAILABLE;
+		freeIndices[i] = N - 1 - i; // Lowest index on top so allocation order matches the old linear scan
 	}
 }
 
@@ -58,34 +67,59 @@ ObjectPool<T, N>::~ObjectPool() {
 
 template <class T, unsigned int N>
 typename T* ObjectPool<T, N>::Allocate() {
-	
-	for (int i = 0; i < N; i++) {
-		if (poolAvailability[i] == AVAILABLE)
-		{
-			usedObjects++;
-			poolAvailability[i] = OCCUPIED;
-			return &pool[i];
-		}
+
+	if (freeCount == 0) {
+		//cout << "There is no capacity for object" << endl;
+		return NULL;
 	}
-	
-	//cout << "There is no capacity for object" << endl;
-	return NULL;
+
+	int index = freeIndices[--freeCount];
+	poolAvailability[index] = OCCUPIED;
+	usedObjects++;
+
+	return &pool[index];
 }
 
 template <class T, unsigned int N>
 bool ObjectPool<T, N>::Free(T* freedObject) {
 
-	for (int i = 0; i < N; i++) {
-		if (freedObject == &pool[i]) {
-			poolAvailability[i] = AVAILABLE;
-			//pool[i] = T(); // Reset the values inside object
-			usedObjects--;
-
-			//cout << "Free is completed returning the value " << endl;
-			return true;
-		}
+	if (!Owns(freedObject)) {
+		//cout << "This object is not in the pool" << endl;
+		return false;
 	}
-	
-	//cout << "This object is not in the pool" << endl;
-	return false;
-}
\ No newline at end of file
+
+	int index = static_cast<int>(freedObject - pool);
+
+	if (poolAvailability[index] == AVAILABLE) // Double free, slot is already on the stack
+		return false;
+
+	poolAvailability[index] = AVAILABLE;
+	freeIndices[freeCount++] = index;
+	usedObjects--;
+
+	//cout << "Free is completed returning the value " << endl;
+	return true;
+}
+
+// Checks whether the pointer points to a slot of this pool
+template <class T, unsigned int N>
+bool ObjectPool<T, N>::Owns(const T* object) const {
+	if (object == NULL)
+		return false;
+
+	// Comparing through integers since relational compare of unrelated pointers is unspecified
+	const char* begin = reinterpret_cast<const char*>(pool);
+	const char* end = reinterpret_cast<const char*>(pool + N);
+	const char* address = reinterpret_cast<const char*>(object);
+
+	if (reinterpret_cast<uintptr_t>(address) < reinterpret_cast<uintptr_t>(begin) ||
+		reinterpret_cast<uintptr_t>(address) >= reinterpret_cast<uintptr_t>(end))
+		return false;
+
+	return (address - begin) % sizeof(T) == 0; // Must point at the start of a slot
+}
+
+template <class T, unsigned int N>
+int ObjectPool<T, N>::GetUsedCount() const {
+	return usedObjects;
+}
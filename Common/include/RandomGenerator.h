@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+
+// xoshiro256** generator. The state is 32 bytes so every thread or solver can own one and no call is shared
+// like rand(). Same seed gives the same numbers on every platform.
+class RandomGenerator {
+public:
+	typedef uint64_t result_type;
+
+	explicit RandomGenerator(uint64_t seed = 0x9E3779B97F4A7C15ULL) {
+		Seed(seed);
+	}
+
+	// Fills the state with splitmix64 so close seeds give unrelated sequences
+	void Seed(uint64_t seed) {
+		for (int i = 0; i < 4; ++i) {
+			seed += 0x9E3779B97F4A7C15ULL;
+			uint64_t z = seed;
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+			state[i] = z ^ (z >> 31);
+		}
+	}
+
+	uint64_t Next() {
+		uint64_t result = RotateLeft(state[1] * 5, 7) * 9;
+		uint64_t t = state[1] << 17;
+
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = RotateLeft(state[3], 45);
+
+		return result;
+	}
+
+	// Uniform in [start, end) without the modulo bias of rand() % range, end has to be larger than start
+	int NextInt(int start, int end) {
+		uint32_t range = static_cast<uint32_t>(end - start);
+		uint64_t product = (Next() >> 32) * range;
+		uint32_t low = static_cast<uint32_t>(product);
+
+		if (low < range) { // Rejects the few values that would make the lower results more likely
+			uint32_t threshold = (0u - range) % range;
+			while (low < threshold) {
+				product = (Next() >> 32) * range;
+				low = static_cast<uint32_t>(product);
+			}
+		}
+
+		return start + static_cast<int>(product >> 32);
+	}
+
+	// Uniform in [0, 1)
+	double NextDouble() {
+		return (Next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	// Same as 2^128 calls of Next, generators jumped 1, 2, 3... times from one seed give streams that don't overlap
+	void Jump() {
+		static const uint64_t JUMP[4] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+		uint64_t jumped[4] = { 0, 0, 0, 0 };
+
+		for (int i = 0; i < 4; ++i) {
+			for (int bit = 0; bit < 64; ++bit) {
+				if (JUMP[i] & (1ULL << bit)) {
+					for (int j = 0; j < 4; ++j)
+						jumped[j] ^= state[j];
+				}
+				Next();
+			}
+		}
+
+		for (int j = 0; j < 4; ++j)
+			state[j] = jumped[j];
+	}
+
+	// Lets the generator be used with the <random> distributions and std::shuffle
+	static constexpr uint64_t min() { return 0; }
+	static constexpr uint64_t max() { return ~0ULL; }
+	uint64_t operator()() { return Next(); }
+
+private:
+	static uint64_t RotateLeft(uint64_t value, int count) {
+		return (value << count) | (value >> (64 - count));
+	}
+
+	uint64_t state[4];
+};
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <iostream>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Number of set bits in a word
+inline int BitCount(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+	return static_cast<int>(__popcnt64(word));
+#elif defined(_MSC_VER)
+	return static_cast<int>(__popcnt(static_cast<unsigned int>(word)) + __popcnt(static_cast<unsigned int>(word >> 32)));
+#else
+	return __builtin_popcountll(word);
+#endif
+}
+
+// Index of the lowest set bit, word must not be zero
+inline int LowestSetBit(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return static_cast<int>(index);
+#elif defined(_MSC_VER)
+	unsigned long index;
+	if (_BitScanForward(&index, static_cast<unsigned long>(word)))
+		return static_cast<int>(index);
+	_BitScanForward(&index, static_cast<unsigned long>(word >> 32));
+	return static_cast<int>(index) + 32;
+#else
+	return __builtin_ctzll(word);
+#endif
+}
+
+// Fixed size bitset stored in 64 bit words, no heap allocation
+template <unsigned int N>
+class StaticBitset {
+public:
+	static const int WORD_BITS = 64;
+	static const int WORD_COUNT = (N + WORD_BITS - 1) / WORD_BITS;
+
+	StaticBitset();
+
+	void Set(int index);
+	void Reset(int index);
+	bool Test(int index) const;
+
+	// Sets or clears every bit
+	void SetAll();
+	void Clear();
+
+	// Returns the number of set bits
+	int Count() const;
+
+	// Returns the number of bits set in this bitset and not set in mask, popcount(this & ~mask)
+	int CountAndNot(const StaticBitset<N>& mask) const;
+
+	bool Any() const;
+
+	// Returns the index of the first set bit, -1 if there is none
+	int FindFirst() const;
+
+	// Returns the index of the first set bit after index, -1 if there is none
+	int FindNext(int index) const;
+
+	// Returns the index of the set bit with rank set bits before it, -1 if there are not that many
+	int Select(int rank) const;
+
+	uint64_t GetWord(int wordIndex) const;
+	void SetWord(int wordIndex, uint64_t word);
+
+	// Clears the bits which are set in other, this &= ~other
+	StaticBitset<N>& AndNot(const StaticBitset<N>& other);
+
+	// Operator Overloading
+	StaticBitset<N>& operator&=(const StaticBitset<N>& other);
+	StaticBitset<N>& operator|=(const StaticBitset<N>& other);
+	StaticBitset<N> operator~() const;
+	bool operator==(const StaticBitset<N>& other) const;
+	bool operator!=(const StaticBitset<N>& other) const;
+
+private:
+	// Mask of the valid bits in the last word
+	static uint64_t LastWordMask();
+
+	uint64_t words[WORD_COUNT];
+};
+
+template <unsigned int N>
+uint64_t StaticBitset<N>::LastWordMask() {
+	return (N % WORD_BITS == 0) ? ~0ULL : ((1ULL << (N % WORD_BITS)) - 1);
+}
+
+template <unsigned int N>
+StaticBitset<N>::StaticBitset() {
+	Clear();
+}
+
+template <unsigned int N>
+void StaticBitset<N>::Set(int index) {
+	words[index / WORD_BITS] |= 1ULL << (index % WORD_BITS);
+}
+
+template <unsigned int N>
+void StaticBitset<N>::Reset(int index) {
+	words[index / WORD_BITS] &= ~(1ULL << (index % WORD_BITS));
+}
+
+template <unsigned int N>
+bool StaticBitset<N>::Test(int index) const {
+	return (words[index / WORD_BITS] >> (index % WORD_BITS)) & 1ULL;
+}
+
+template <unsigned int N>
+void StaticBitset<N>::SetAll() {
+	for (int i = 0; i < WORD_COUNT; ++i)
+		words[i] = ~0ULL;
+
+	words[WORD_COUNT - 1] &= LastWordMask();
+}
+
+template <unsigned int N>
+void StaticBitset<N>::Clear() {
+	for (int i = 0; i < WORD_COUNT; ++i)
+		words[i] = 0;
+}
+
+template <unsigned int N>
+int StaticBitset<N>::Count() const {
+	int count = 0;
+	for (int i = 0; i < WORD_COUNT; ++i)
+		count += BitCount(words[i]);
+
+	return count;
+}
+
+template <unsigned int N>
+int StaticBitset<N>::CountAndNot(const StaticBitset<N>& mask) const {
+	int count = 0;
+	for (int i = 0; i < WORD_COUNT; ++i)
+		count += BitCount(words[i] & ~mask.words[i]);
+
+	return count;
+}
+
+template <unsigned int N>
+bool StaticBitset<N>::Any() const {
+	for (int i = 0; i < WORD_COUNT; ++i) {
+		if (words[i] != 0)
+			return true;
+	}
+
+	return false;
+}
+
+template <unsigned int N>
+int StaticBitset<N>::FindFirst() const {
+	for (int i = 0; i < WORD_COUNT; ++i) {
+		if (words[i] != 0)
+			return i * WORD_BITS + LowestSetBit(words[i]);
+	}
+
+	return -1;
+}
+
+template <unsigned int N>
+int StaticBitset<N>::FindNext(int index) const {
+	index++;
+	if (index >= static_cast<int>(N))
+		return -1;
+
+	int wordIndex = index / WORD_BITS;
+	uint64_t word = words[wordIndex] & (~0ULL << (index % WORD_BITS)); // Dropping the bits before index
+
+	while (true) {
+		if (word != 0)
+			return wordIndex * WORD_BITS + LowestSetBit(word);
+
+		if (++wordIndex >= WORD_COUNT)
+			return -1;
+
+		word = words[wordIndex];
+	}
+}
+
+template <unsigned int N>
+int StaticBitset<N>::Select(int rank) const {
+	for (int i = 0; i < WORD_COUNT; ++i) {
+		int count = BitCount(words[i]);
+
+		if (rank < count) {
+			uint64_t word = words[i];
+			for (; rank > 0; --rank)
+				word &= word - 1; // Dropping the lowest set bit
+
+			return i * WORD_BITS + LowestSetBit(word);
+		}
+
+		rank -= count;
+	}
+
+	return -1;
+}
+
+template <unsigned int N>
+uint64_t StaticBitset<N>::GetWord(int wordIndex) const {
+	return words[wordIndex];
+}
+
+template <unsigned int N>
+void StaticBitset<N>::SetWord(int wordIndex, uint64_t word) {
+	words[wordIndex] = (wordIndex == WORD_COUNT - 1) ? (word & LastWordMask()) : word;
+}
+
+template <unsigned int N>
+StaticBitset<N>& StaticBitset<N>::AndNot(const StaticBitset<N>& other) {
+	for (int i = 0; i < WORD_COUNT; ++i)
+		words[i] &= ~other.words[i];
+
+	return *this;
+}
+
+template <unsigned int N>
+StaticBitset<N>& StaticBitset<N>::operator&=(const StaticBitset<N>& other) {
+	for (int i = 0; i < WORD_COUNT; ++i)
+		words[i] &= other.words[i];
+
+	return *this;
+}
+
+template <unsigned int N>
+StaticBitset<N>& StaticBitset<N>::operator|=(const StaticBitset<N>& other) {
+	for (int i = 0; i < WORD_COUNT; ++i)
+		words[i] |= other.words[i];
+
+	return *this;
+}
+
+template <unsigned int N>
+StaticBitset<N> StaticBitset<N>::operator~() const {
+	StaticBitset<N> result;
+	for (int i = 0; i < WORD_COUNT; ++i)
+		result.words[i] = ~words[i];
+
+	result.words[WORD_COUNT - 1] &= LastWordMask(); // Bits past N must stay zero for Count
+	return result;
+}
+
+template <unsigned int N>
+bool StaticBitset<N>::operator==(const StaticBitset<N>& other) const {
+	for (int i = 0; i < WORD_COUNT; ++i) {
+		if (words[i] != other.words[i])
+			return false;
+	}
+
+	return true;
+}
+
+template <unsigned int N>
+bool StaticBitset<N>::operator!=(const StaticBitset<N>& other) const {
+	return !(*this == other);
+}
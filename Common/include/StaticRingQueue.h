@@ -0,0 +1,94 @@
+#pragma once
+
+// Fixed capacity FIFO queue in an array. The head and the tail wrap around the array, so Push and Pop are O(1)
+// and elements are never moved or allocated. Push fails when N elements are queued, like a full ObjectPool.
+template <class T, unsigned int N>
+class StaticRingQueue {
+public:
+	StaticRingQueue();
+
+	// Adds the element after the last one, false if the queue is full
+	bool Push(const T& element);
+
+	// Removes the first element, false if the queue is empty
+	bool Pop();
+
+	// First and last queued elements, the queue must not be empty
+	T& Front();
+	T& Back();
+
+	int GetSize() const;
+	bool IsEmpty() const;
+	bool IsFull() const;
+	void Clear();
+
+private:
+	T data[N];
+	int head; // Index of the first element
+	int size;
+};
+
+template <class T, unsigned int N>
+StaticRingQueue<T, N>::StaticRingQueue() : head(0), size(0) {
+}
+
+template <class T, unsigned int N>
+bool StaticRingQueue<T, N>::Push(const T& element) {
+	if (size == N)
+		return false;
+
+	int tail = head + size;
+	if (tail >= N)
+		tail -= N;
+
+	data[tail] = element;
+	size++;
+	return true;
+}
+
+template <class T, unsigned int N>
+bool StaticRingQueue<T, N>::Pop() {
+	if (size == 0)
+		return false;
+
+	if (++head == N)
+		head = 0;
+
+	size--;
+	return true;
+}
+
+template <class T, unsigned int N>
+T& StaticRingQueue<T, N>::Front() {
+	return data[head];
+}
+
+template <class T, unsigned int N>
+T& StaticRingQueue<T, N>::Back() {
+	int tail = head + size - 1;
+	if (tail >= N)
+		tail -= N;
+
+	return data[tail];
+}
+
+template <class T, unsigned int N>
+int StaticRingQueue<T, N>::GetSize() const {
+	return size;
+}
+
+template <class T, unsigned int N>
+bool StaticRingQueue<T, N>::IsEmpty() const {
+	return size == 0;
+}
+
+template <class T, unsigned int N>
+bool StaticRingQueue<T, N>::IsFull() const {
+	return size == N;
+}
+
+template <class T, unsigned int N>
+void StaticRingQueue<T, N>::Clear() {
+	head = 0;
+	size = 0;
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+#include <memory>
+
+// Thread pool which runs index ranges in parallel.
+// Every worker starts with a contiguous part of the range and takes indices from its front,
+// a worker without work steals the back half of another worker's remaining range.
+// Threads are created once and reused for every ParallelFor call.
+class WorkStealingThreadPool {
+public:
+	// threadCount <= 0 uses the number of hardware threads
+	explicit WorkStealingThreadPool(int threadCount = 0);
+	~WorkStealingThreadPool();
+
+	WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+	WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+	int GetThreadCount() const;
+
+	// Calls function(index, workerIndex) for every index in [0, count) and returns when all calls are finished.
+	// workerIndex is in [0, GetThreadCount()) and can be used to select per thread buffers.
+	void ParallelFor(int count, const std::function<void(int, int)>& function);
+
+private:
+	struct WorkerRange {
+		std::mutex lock;
+		int begin = 0;
+		int end = 0;
+	};
+
+	void WorkerLoop(int worker);
+	void RunWorker(int worker);
+	bool PopOwn(int worker, int& index);
+	bool Steal(int thief);
+
+	std::vector<std::thread> threads;
+	std::unique_ptr<WorkerRange[]> ranges;
+	int threadCount;
+
+	std::mutex jobLock;
+	std::condition_variable jobStarted;
+	std::condition_variable jobFinished;
+	const std::function<void(int, int)>* job;
+	unsigned int jobGeneration;
+	int runningWorkers;
+	bool stopping;
+};
+
+inline WorkStealingThreadPool::WorkStealingThreadPool(int count) : job(nullptr), jobGeneration(0), runningWorkers(0), stopping(false) {
+	if (count <= 0)
+		count = static_cast<int>(std::thread::hardware_concurrency());
+	if (count <= 0)
+		count = 1;
+
+	threadCount = count;
+	ranges.reset(new WorkerRange[threadCount]);
+
+	for (int i = 0; i < threadCount; ++i)
+		threads.emplace_back(&WorkStealingThreadPool::WorkerLoop, this, i);
+}
+
+inline WorkStealingThreadPool::~WorkStealingThreadPool() {
+	{
+		std::lock_guard<std::mutex> guard(jobLock);
+		stopping = true;
+	}
+	jobStarted.notify_all();
+
+	for (size_t i = 0; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+inline int WorkStealingThreadPool::GetThreadCount() const {
+	return threadCount;
+}
+
+inline void WorkStealingThreadPool::ParallelFor(int count, const std::function<void(int, int)>& function) {
+	if (count <= 0)
+		return;
+
+	// Splitting the range evenly, workers steal from each other when the work is uneven
+	for (int i = 0; i < threadCount; ++i) {
+		std::lock_guard<std::mutex> guard(ranges[i].lock);
+		ranges[i].begin = static_cast<int>(static_cast<long long>(count) * i / threadCount);
+		ranges[i].end = static_cast<int>(static_cast<long long>(count) * (i + 1) / threadCount);
+	}
+
+	std::unique_lock<std::mutex> lock(jobLock);
+	job = &function;
+	runningWorkers = threadCount;
+	jobGeneration++;
+	jobStarted.notify_all();
+
+	jobFinished.wait(lock, [this]() { return runningWorkers == 0; });
+	job = nullptr;
+}
+
+inline void WorkStealingThreadPool::WorkerLoop(int worker) {
+	unsigned int seenGeneration = 0;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(jobLock);
+			jobStarted.wait(lock, [&]() { return stopping || jobGeneration != seenGeneration; });
+
+			if (stopping)
+				return;
+
+			seenGeneration = jobGeneration;
+		}
+
+		RunWorker(worker);
+
+		std::lock_guard<std::mutex> guard(jobLock);
+		if (--runningWorkers == 0)
+			jobFinished.notify_one();
+	}
+}
+
+inline void WorkStealingThreadPool::RunWorker(int worker) {
+	int index;
+
+	while (true) {
+		while (PopOwn(worker, index))
+			(*job)(index, worker);
+
+		if (!Steal(worker))
+			return; // Every range is empty
+	}
+}
+
+inline bool WorkStealingThreadPool::PopOwn(int worker, int& index) {
+	std::lock_guard<std::mutex> guard(ranges[worker].lock);
+
+	if (ranges[worker].begin >= ranges[worker].end)
+		return false;
+
+	index = ranges[worker].begin++;
+	return true;
+}
+
+inline bool WorkStealingThreadPool::Steal(int thief) {
+	for (int offset = 1; offset < threadCount; ++offset) {
+		int victim = (thief + offset) % threadCount;
+		int stolenBegin;
+		int stolenEnd;
+
+		{
+			std::lock_guard<std::mutex> guard(ranges[victim].lock);
+			int remaining = ranges[victim].end - ranges[victim].begin;
+
+			if (remaining <= 0)
+				continue;
+
+			// Taking the back half, the victim keeps working from its front
+			stolenEnd = ranges[victim].end;
+			stolenBegin = stolenEnd - (remaining + 1) / 2;
+			ranges[victim].end = stolenBegin;
+		}
+
+		std::lock_guard<std::mutex> guard(ranges[thief].lock);
+		ranges[thief].begin = stolenBegin;
+		ranges[thief].end = stolenEnd;
+		return true;
+	}
+
+	return false;
+}
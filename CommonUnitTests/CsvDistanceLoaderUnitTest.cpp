@@ -0,0 +1,156 @@
+#include <CsvDistanceLoader.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+class CsvDistanceLoaderTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+
+	CsvLoadResult Load(const std::string& text, std::unique_ptr<RuntimeGraph>& graph, WorkStealingThreadPool* pool = NULL) {
+		CsvDistanceLoader loader(pool);
+		return loader.Load(text.data(), text.size(), graph);
+	}
+
+	// Errors have to name the line and contain the text
+	void ExpectError(const CsvLoadResult& result, int line, const std::string& text) {
+		EXPECT_FALSE(result.success);
+		ASSERT_FALSE(result.errors.empty());
+		EXPECT_EQ(result.errors[0].line, line);
+		EXPECT_NE(result.errors[0].message.find(text), std::string::npos) << result.errors[0].message;
+	}
+};
+
+// Test case for a BOM, a Windows-1254 title and a column header line being skipped
+TEST_F(CsvDistanceLoaderTest, SkipsHeaderLines) {
+	std::string text = "\xEF\xBB\xBF\xDDLLER ARASI MESAFE CETVEL\xDD;;;;\r\n"
+		"IL PLAKA NO;IL ADI;ADANA;ANKARA;BURSA\r\n"
+		"01;ADANA;0;492;750\r\n"
+		"06;ANKARA;492;0;385\r\n"
+		"16;BURSA;750;385;0\r\n";
+	std::unique_ptr<RuntimeGraph> graph;
+
+	CsvLoadResult result = Load(text, graph);
+
+	EXPECT_TRUE(result.success);
+	EXPECT_EQ(result.headerLineCount, 2);
+	EXPECT_EQ(result.cityCount, 3);
+	EXPECT_EQ(graph->GetNames()[1], "ANKARA");
+	EXPECT_EQ(graph->Distance(0, 1), 492);
+	EXPECT_EQ(graph->Distance(1, 2), 385);
+	EXPECT_EQ(graph->Distance(2, 0), 750);
+}
+
+// Test case for the rows of only separators at the end of ilmesafe.csv being ignored
+TEST_F(CsvDistanceLoaderTest, IgnoresTrailingSeparatorRows) {
+	std::string text = "01;A;0;5;\n"
+		"02;B;5;0;;\n"
+		";;;;\n"
+		" ; ;\n";
+	std::unique_ptr<RuntimeGraph> graph;
+
+	CsvLoadResult result = Load(text, graph);
+
+	EXPECT_TRUE(result.success);
+	EXPECT_EQ(result.cityCount, 2);
+	EXPECT_EQ(graph->Distance(1, 0), 5);
+}
+
+// Test case for a row with fewer distances than cities
+TEST_F(CsvDistanceLoaderTest, ReportsShortRow) {
+	std::string text = "title\n"
+		"01;A;0;5;7\n"
+		"02;B;5;0\n"
+		"03;C;7;3;0\n";
+	std::unique_ptr<RuntimeGraph> graph;
+
+	ExpectError(Load(text, graph), 3, "B has 2 distances, expected 3");
+}
+
+// Test case for a row with more distances than cities
+TEST_F(CsvDistanceLoaderTest, ReportsLongRow) {
+	std::string text = "01;A;0;5\n"
+		"02;B;5;0;9\n";
+	std::unique_ptr<RuntimeGraph> graph;
+
+	ExpectError(Load(text, graph), 2, "B has more than 2 distances");
+}
+
+// Test case for fields which are not numbers
+TEST_F(CsvDistanceLoaderTest, ReportsNonNumericField) {
+	std::unique_ptr<RuntimeGraph> graph;
+
+	ExpectError(Load("01;A;0;x5\n02;B;5;0\n", graph), 1, "distance 2 of A is not a number");
+	ExpectError(Load("01;A;0;5\n02;B;5 1;0\n", graph), 2, "distance 1 of B is not a number");
+	ExpectError(Load("01;A;0;5\n02;B;;0\n", graph), 2, "distance 1 of B is not a number");
+	ExpectError(Load("01;A;0;- ;\n02;B;5;0\n", graph), 1, "distance 2 of A is not a number");
+	ExpectError(Load("01;A;0;5\n02;B;-  ;0\n", graph), 2, "distance 1 of B is not a number");
+	ExpectError(Load("01;A;0;5\n02;B;5;-\n", graph), 2, "distance 2 of B is not a number");
+}
+
+// Test case for digit runs which don't fit an int being reported instead of overflowing
+TEST_F(CsvDistanceLoaderTest, ReportsTooLargeField) {
+	std::unique_ptr<RuntimeGraph> graph;
+
+	ExpectError(Load("01;A;0;99999999999999999999\n02;B;5;0\n", graph), 1, "distance 2 of A is too large");
+	ExpectError(Load("01;A;0;2147483648\n02;B;5;0\n", graph), 1, "is too large");
+
+	CsvLoadResult result = Load("01;A;0;2147483647\n02;B;5;0\n", graph);
+	EXPECT_TRUE(result.success);
+	EXPECT_EQ(graph->Distance(0, 1), 2147483647);
+}
+
+// Test case for a line between the city rows which is not a city row
+TEST_F(CsvDistanceLoaderTest, ReportsLineBetweenRows) {
+	std::string text = "01;A;0;5\n"
+		"comment\n"
+		"02;B;5;0\n";
+	std::unique_ptr<RuntimeGraph> graph;
+
+	ExpectError(Load(text, graph), 2, "not a city row");
+}
+
+// Test case for the pool giving the same table and the same errors as the calling thread
+TEST_F(CsvDistanceLoaderTest, PooledSameAsSingleThread) {
+	const int cityCount = CsvDistanceLoader::PARALLEL_CITY_COUNT + 100;
+	std::string text = "IL PLAKA NO;IL ADI\n";
+
+	for (int i = 0; i < cityCount; ++i) {
+		text += std::to_string(i + 1) + ";CITY" + std::to_string(i);
+		int columns = (i % 97 == 5) ? cityCount - 1 : cityCount; // A few short rows
+		for (int j = 0; j < columns; ++j)
+			text += ";" + ((i * 31 + j) % 211 == 0 ? std::string("x") : std::to_string((i * 7 + j * 13) % 1000));
+		text += "\n";
+	}
+
+	WorkStealingThreadPool pool(4);
+	std::unique_ptr<RuntimeGraph> single;
+	std::unique_ptr<RuntimeGraph> pooled;
+
+	CsvLoadResult singleResult = Load(text, single);
+	CsvLoadResult pooledResult = Load(text, pooled, &pool);
+
+	EXPECT_FALSE(singleResult.success);
+	ASSERT_EQ(singleResult.cityCount, cityCount);
+	ASSERT_EQ(pooledResult.cityCount, cityCount);
+	ASSERT_EQ(singleResult.errors.size(), pooledResult.errors.size());
+	for (size_t i = 0; i < singleResult.errors.size(); ++i) {
+		EXPECT_EQ(singleResult.errors[i].line, pooledResult.errors[i].line);
+		EXPECT_EQ(singleResult.errors[i].message, pooledResult.errors[i].message);
+	}
+
+	for (int i = 0; i < cityCount; ++i) {
+		EXPECT_EQ(single->GetNames()[i], pooled->GetNames()[i]);
+		for (int j = 0; j < cityCount; j += 17)
+			EXPECT_EQ(single->Distance(i, j), pooled->Distance(i, j));
+	}
+}
+
+void RunCsvDistanceLoaderTests() {
+	::testing::InitGoogleTest();
+	RUN_ALL_TESTS();
+}
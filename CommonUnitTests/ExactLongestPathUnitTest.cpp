@@ -0,0 +1,137 @@
+#include <ExactLongestPath.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+
+const int EXACT_CITY_COUNT = 64;
+
+class ExactLongestPathTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		graph.reset(new BitAdjacency<EXACT_CITY_COUNT>());
+		solver.reset(new ExactLongestPathSolver<EXACT_CITY_COUNT>());
+	}
+
+	// Plain DFS over every simple path from the city, for graphs small enough to enumerate
+	int BruteForceLongestPath(int city, bool* visited) {
+		visited[city] = true;
+		int longest = 0;
+		for (int neighbor = 0; neighbor < EXACT_CITY_COUNT; ++neighbor) {
+			if (!visited[neighbor] && graph->HasEdge(city, neighbor)) {
+				int length = BruteForceLongestPath(neighbor, visited);
+				if (length > longest)
+					longest = length;
+			}
+		}
+		visited[city] = false;
+		return longest + 1;
+	}
+
+	// The path has to start at the city, visit every city once, follow edges and be as long as the lower bound
+	void ExpectValidPath(ExactLongestPathResult<EXACT_CITY_COUNT> result, int startCity) {
+		ASSERT_EQ(result.path.GetSize(), result.lowerBound);
+		ASSERT_GT(result.lowerBound, 0);
+		EXPECT_EQ(result.path[0], startCity);
+
+		bool visited[EXACT_CITY_COUNT] = { false };
+		for (int i = 0; i < result.lowerBound; ++i) {
+			ASSERT_FALSE(visited[result.path[i]]) << "city " << result.path[i] << " visited twice";
+			visited[result.path[i]] = true;
+			if (i > 0)
+				ASSERT_TRUE(graph->HasEdge(result.path[i - 1], result.path[i])) << "at " << i;
+		}
+	}
+
+	// Certified result with the known optimum
+	void ExpectOptimum(int startCity, int optimum) {
+		ExactLongestPathResult<EXACT_CITY_COUNT> result = solver->Solve(*graph, startCity, 0);
+		ExpectValidPath(result, startCity);
+		EXPECT_TRUE(result.certified) << "from " << startCity;
+		EXPECT_EQ(result.lowerBound, optimum) << "from " << startCity;
+		EXPECT_EQ(result.upperBound, optimum) << "from " << startCity;
+	}
+
+	std::unique_ptr<BitAdjacency<EXACT_CITY_COUNT>> graph;
+	std::unique_ptr<ExactLongestPathSolver<EXACT_CITY_COUNT>> solver;
+};
+
+// Test case for a path 0-1-...-9, from an end and from the middle
+TEST_F(ExactLongestPathTest, PathGraph) {
+	for (int i = 0; i < 9; ++i)
+		graph->AddEdge(i, i + 1);
+
+	ExpectOptimum(0, 10);
+	ExpectOptimum(9, 10);
+	ExpectOptimum(4, 6);
+	ExpectOptimum(20, 1); // Isolated city
+}
+
+// Test case for a star, from the center and from a leaf
+TEST_F(ExactLongestPathTest, StarGraph) {
+	for (int i = 1; i <= 7; ++i)
+		graph->AddEdge(0, i);
+
+	ExpectOptimum(0, 2);
+	ExpectOptimum(5, 3);
+}
+
+// Test case for a cycle, every city reaches all the others
+TEST_F(ExactLongestPathTest, CycleGraph) {
+	for (int i = 0; i < 12; ++i)
+		graph->AddEdge(i, (i + 1) % 12);
+
+	for (int i = 0; i < 12; ++i)
+		ExpectOptimum(i, 12);
+}
+
+// Test case for a complete binary tree of 15 cities numbered like a heap
+TEST_F(ExactLongestPathTest, TreeGraph) {
+	for (int i = 1; i < 15; ++i)
+		graph->AddEdge(i, (i - 1) / 2);
+
+	ExpectOptimum(0, 4); // Root down to a leaf
+	ExpectOptimum(1, 5); // Up to the root and down the other side
+	ExpectOptimum(7, 7); // Leaf to a leaf of the other subtree
+}
+
+// Test case for random graphs of different densities against a brute force search
+TEST_F(ExactLongestPathTest, RandomGraphsMatchBruteForce) {
+	std::mt19937 generator(29);
+	const int cityCount = 10;
+
+	for (int round = 0; round < 30; ++round) {
+		graph->Clear();
+		int density = 10 + round * 2;
+		for (int i = 0; i < cityCount; ++i) {
+			for (int j = i + 1; j < cityCount; ++j) {
+				if (static_cast<int>(generator() % 100) < density)
+					graph->AddEdge(i, j);
+			}
+		}
+
+		for (int city = 0; city < cityCount; ++city) {
+			bool visited[EXACT_CITY_COUNT] = { false };
+			ExpectOptimum(city, BruteForceLongestPath(city, visited));
+		}
+	}
+}
+
+// Test case for a search cut by the time budget. A complete bipartite graph of 24 and 27 cities
+// has the optimum 49 from the larger side, the bound can't prove it before the budget runs out.
+TEST_F(ExactLongestPathTest, TimeBudgetGivesBounds) {
+	for (int i = 0; i < 24; ++i) {
+		for (int j = 24; j < 51; ++j)
+			graph->AddEdge(i, j);
+	}
+
+	ExactLongestPathResult<EXACT_CITY_COUNT> result = solver->Solve(*graph, 30, 1);
+	ExpectValidPath(result, 30);
+	EXPECT_FALSE(result.certified);
+	EXPECT_LE(result.lowerBound, 49);
+	EXPECT_GE(result.upperBound, 49);
+}
+
+void RunExactLongestPathTests() {
+	::testing::InitGoogleTest();
+	RUN_ALL_TESTS();
+}
@@ -0,0 +1,116 @@
+#include <FrontierBfs.h>
+#include <StaticBitsetLibrary.h>
+#include <StaticRingQueue.h>
+#include <gtest/gtest.h>
+
+// Undirected graph with a bit row per city, the rows FrontierBfs reads
+template <unsigned int N>
+struct TestGraph {
+	StaticBitset<N> rows[N];
+
+	void AddEdge(int from, int to) {
+		rows[from].Set(to);
+		rows[to].Set(from);
+	}
+
+	const StaticBitset<N>& Row(int city) const {
+		return rows[city];
+	}
+};
+
+// Queue based BFS to compare the levels with
+template <unsigned int N>
+void QueueBfs(const TestGraph<N>& graph, int source, int levels[N]) {
+	StaticRingQueue<int, N> queue;
+
+	for (int i = 0; i < N; ++i)
+		levels[i] = -1;
+
+	levels[source] = 0;
+	queue.Push(source);
+
+	while (!queue.IsEmpty()) {
+		int city = queue.Front();
+		queue.Pop();
+
+		for (int neighbor = graph.Row(city).FindFirst(); neighbor != -1; neighbor = graph.Row(city).FindNext(neighbor)) {
+			if (levels[neighbor] == -1) {
+				levels[neighbor] = levels[city] + 1;
+				queue.Push(neighbor);
+			}
+		}
+	}
+}
+
+class FrontierBfsTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+// Test case for the levels of a path and the cities it can't reach
+TEST_F(FrontierBfsTest, PathLevels) {
+	TestGraph<6> graph;
+	graph.AddEdge(0, 1);
+	graph.AddEdge(1, 2);
+	graph.AddEdge(2, 3);
+	graph.AddEdge(4, 5);
+
+	int levels[6];
+	EXPECT_EQ(FrontierBfs<6>(graph, 1, levels), 2);
+
+	EXPECT_EQ(levels[0], 1);
+	EXPECT_EQ(levels[1], 0);
+	EXPECT_EQ(levels[2], 1);
+	EXPECT_EQ(levels[3], 2);
+	EXPECT_EQ(levels[4], -1);
+	EXPECT_EQ(levels[5], -1);
+}
+
+// Test case for a city without neighbors
+TEST_F(FrontierBfsTest, IsolatedSource) {
+	TestGraph<3> graph;
+	graph.AddEdge(1, 2);
+
+	int levels[3];
+	EXPECT_EQ(FrontierBfs<3>(graph, 0, levels), 0);
+	EXPECT_EQ(levels[0], 0);
+	EXPECT_EQ(levels[1], -1);
+	EXPECT_EQ(levels[2], -1);
+}
+
+// Test case for the same levels as a queue based BFS on graphs wider than one word
+TEST_F(FrontierBfsTest, SameAsQueueBfs) {
+	const int N = 150;
+	unsigned int state = 12345;
+
+	for (int density = 1; density <= 5; ++density) {
+		TestGraph<N> graph;
+
+		for (int i = 0; i < N; ++i) {
+			for (int j = i + 1; j < N; ++j) {
+				state = state * 1103515245u + 12345u;
+				if ((state >> 16) % 100 < static_cast<unsigned int>(density))
+					graph.AddEdge(i, j);
+			}
+		}
+
+		for (int source = 0; source < N; source += 7) {
+			int levels[N];
+			int expected[N];
+			FrontierBfs<N>(graph, source, levels);
+			QueueBfs<N>(graph, source, expected);
+
+			for (int i = 0; i < N; ++i)
+				EXPECT_EQ(levels[i], expected[i]);
+		}
+	}
+}
+
+void RunFrontierBfsTests() {
+	::testing::InitGoogleTest();
+	RUN_ALL_TESTS();
+}
@@ -0,0 +1,135 @@
+#include <GraphCache.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+class GraphCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		fileName = "GraphCacheUnitTest.graph";
+		bands.push_back(GraphCacheBand{ 200, 300 });
+
+		// 70 cities so a bit row has two words
+		source.reset(new RuntimeGraph(70));
+		std::mt19937 generator(5);
+		for (int i = 0; i < source->GetCityCount(); ++i) {
+			source->GetNames()[i] = "CITY" + std::to_string(i);
+			for (int j = 0; j < source->GetCityCount(); ++j)
+				source->DistanceRow(i)[j] = (i == j) ? 0 : static_cast<int>(generator() % 600);
+		}
+
+		stamp.size = 1234;
+		stamp.modified = 5678;
+	}
+
+	void TearDown() override {
+		std::remove(fileName.c_str());
+	}
+
+	// Same names, distances and band edges as the table the cache was written from
+	void ExpectSameTable(RuntimeGraph& graph) {
+		ASSERT_EQ(graph.GetCityCount(), source->GetCityCount());
+		source->FilterBand(200, 300);
+
+		for (int i = 0; i < graph.GetCityCount(); ++i) {
+			EXPECT_EQ(graph.GetNames()[i], source->GetNames()[i]);
+			for (int j = 0; j < graph.GetCityCount(); ++j) {
+				ASSERT_EQ(graph.Distance(i, j), source->Distance(i, j)) << i << ", " << j;
+				ASSERT_EQ(graph.Edge(i, j), source->Edge(i, j)) << i << ", " << j;
+			}
+		}
+	}
+
+	std::string fileName;
+	std::vector<GraphCacheBand> bands;
+	std::unique_ptr<RuntimeGraph> source;
+	FileStamp stamp;
+};
+
+// Test case for a graph read from the mapped distances of the cache
+TEST_F(GraphCacheTest, LoadSharesCachedDistances) {
+	ASSERT_TRUE(GraphCache::Write(fileName, *source, 42, stamp, bands));
+
+	GraphCache cache;
+	ASSERT_TRUE(cache.Open(fileName));
+	EXPECT_EQ(cache.GetSourceHash(), 42u);
+	EXPECT_TRUE(cache.HasSourceStamp(stamp));
+	EXPECT_TRUE(cache.HasBand(200, 300));
+	EXPECT_FALSE(cache.HasBand(200, 301));
+
+	std::unique_ptr<RuntimeGraph> graph;
+	ASSERT_TRUE(cache.Load(graph));
+	EXPECT_FALSE(graph->OwnsDistances());
+	ASSERT_TRUE(cache.LoadBand(*graph, 200, 300));
+	ExpectSameTable(*graph);
+
+	// Filtering the shared distances gives the cached band
+	graph->FilterBand(200, 300);
+	ExpectSameTable(*graph);
+}
+
+// Test case for a loaded graph outliving its cache while the cache file is written again
+TEST_F(GraphCacheTest, GraphKeepsMappingAfterRewrite) {
+	ASSERT_TRUE(GraphCache::Write(fileName, *source, 42, stamp, bands));
+
+	std::unique_ptr<RuntimeGraph> graph;
+	{
+		GraphCache cache;
+		ASSERT_TRUE(cache.Open(fileName));
+		ASSERT_TRUE(cache.Load(graph));
+		ASSERT_TRUE(cache.LoadBand(*graph, 200, 300));
+	}
+
+	std::unique_ptr<RuntimeGraph> other(new RuntimeGraph(3));
+	GraphCache::Write(fileName, *other, 7, stamp, bands); // Can fail on Windows while the graph maps the file
+
+	ExpectSameTable(*graph);
+}
+
+// Test case for a new source stamp keeping the rest of the cache valid
+TEST_F(GraphCacheTest, WriteSourceStamp) {
+	ASSERT_TRUE(GraphCache::Write(fileName, *source, 42, stamp, bands));
+
+	FileStamp newStamp;
+	newStamp.size = 1234;
+	newStamp.modified = 9999;
+	ASSERT_TRUE(GraphCache::WriteSourceStamp(fileName, newStamp));
+
+	GraphCache cache;
+	ASSERT_TRUE(cache.Open(fileName));
+	EXPECT_TRUE(cache.HasSourceStamp(newStamp));
+	EXPECT_FALSE(cache.HasSourceStamp(stamp));
+	EXPECT_EQ(cache.GetSourceHash(), 42u);
+
+	std::unique_ptr<RuntimeGraph> graph;
+	ASSERT_TRUE(cache.Load(graph));
+	ASSERT_TRUE(cache.LoadBand(*graph, 200, 300));
+	ExpectSameTable(*graph);
+}
+
+// Test case for tables the 16 bit format can't hold and for damaged files
+TEST_F(GraphCacheTest, RejectsTablesAndFiles) {
+	source->DistanceRow(1)[2] = 70000;
+	EXPECT_FALSE(GraphCache::Write(fileName, *source, 42, stamp, bands));
+	source->DistanceRow(1)[2] = 10;
+
+	ASSERT_TRUE(GraphCache::Write(fileName, *source, 42, stamp, bands));
+	{
+		std::fstream file(fileName, std::ios::in | std::ios::out | std::ios::binary);
+		file.seekp(sizeof(GraphCacheHeader) + 20);
+		file.put('X');
+	}
+
+	GraphCache cache;
+	EXPECT_FALSE(cache.Open(fileName));
+	EXPECT_FALSE(cache.IsOpen());
+	EXPECT_FALSE(GraphCache().Open("GraphCacheUnitTest.missing"));
+}
+
+void RunGraphCacheTests() {
+	::testing::InitGoogleTest();
+	RUN_ALL_TESTS();
+}
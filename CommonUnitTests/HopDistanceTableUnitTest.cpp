@@ -0,0 +1,160 @@
+#include <Algorithms.h>
+#include <HopDistanceTable.h>
+#include <StaticRingQueue.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+
+// More than one word per bit row
+const int HOP_CITY_COUNT = 100;
+
+typedef StaticVector<StaticVector<int, HOP_CITY_COUNT>, HOP_CITY_COUNT> HopMatrix;
+
+class HopDistanceTableTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		graph.reset(new HopMatrix());
+		table.reset(new HopDistanceTable<HOP_CITY_COUNT>());
+		generator.seed(31);
+	}
+
+	// Sparse enough for long hop distances and cities which can't reach each other
+	void BuildRandomGraph(int percent) {
+		for (int i = 0; i < HOP_CITY_COUNT; ++i) {
+			(*graph)[i][i] = 0;
+			for (int j = i + 1; j < HOP_CITY_COUNT; ++j) {
+				int edge = (static_cast<int>(generator() % 100) < percent) ? 1 : 0;
+				(*graph)[i][j] = edge;
+				(*graph)[j][i] = edge;
+			}
+		}
+	}
+
+	void RemoveFromGraph(int city) {
+		for (int i = 0; i < HOP_CITY_COUNT; ++i) {
+			(*graph)[city][i] = 0;
+			(*graph)[i][city] = 0;
+		}
+	}
+
+	// Queue based BFS on the matrix, -1 for the cities the source can't reach
+	void PlainBfs(int source, int levels[HOP_CITY_COUNT]) {
+		StaticRingQueue<int, HOP_CITY_COUNT> queue;
+
+		for (int i = 0; i < HOP_CITY_COUNT; ++i)
+			levels[i] = -1;
+
+		levels[source] = 0;
+		queue.Push(source);
+
+		while (!queue.IsEmpty()) {
+			int city = queue.Front();
+			queue.Pop();
+
+			for (int neighbor = 0; neighbor < HOP_CITY_COUNT; ++neighbor) {
+				if ((*graph)[city][neighbor] && levels[neighbor] == -1) {
+					levels[neighbor] = levels[city] + 1;
+					queue.Push(neighbor);
+				}
+			}
+		}
+	}
+
+	int PlainDistanceSum(int source) {
+		int levels[HOP_CITY_COUNT];
+		PlainBfs(source, levels);
+
+		int sum = 0;
+		for (int i = 0; i < HOP_CITY_COUNT; ++i) {
+			if (levels[i] > 0)
+				sum += levels[i];
+		}
+		return sum;
+	}
+
+	void ExpectSameAsPlainBfs() {
+		for (int source = 0; source < HOP_CITY_COUNT; ++source) {
+			int levels[HOP_CITY_COUNT];
+			PlainBfs(source, levels);
+
+			ASSERT_EQ(table->DistanceSum(source), PlainDistanceSum(source)) << "from " << source;
+			for (int i = 0; i < HOP_CITY_COUNT; ++i) {
+				int expected = levels[i] == -1 ? HopDistanceTable<HOP_CITY_COUNT>::UNREACHABLE : levels[i];
+				ASSERT_EQ(table->Distance(source, i), expected) << "from " << source << " to " << i;
+			}
+		}
+	}
+
+	std::unique_ptr<HopMatrix> graph;
+	std::unique_ptr<HopDistanceTable<HOP_CITY_COUNT>> table;
+	std::mt19937 generator;
+};
+
+// Test case for the distances of a freshly built table
+TEST_F(HopDistanceTableTest, BuildMatchesPlainBfs) {
+	BuildRandomGraph(3);
+	table->Build(*graph);
+	ExpectSameAsPlainBfs();
+}
+
+// Test case for the rows left valid by RemoveVertex, every row is computed before the removals
+TEST_F(HopDistanceTableTest, RemoveVertexMatchesPlainBfs) {
+	BuildRandomGraph(4);
+	table->Build(*graph);
+	table->ComputeAll();
+
+	for (int removed = 0; removed < 30; ++removed) {
+		int city = static_cast<int>(generator() % HOP_CITY_COUNT);
+		table->RemoveVertex(city);
+		RemoveFromGraph(city);
+		ExpectSameAsPlainBfs();
+	}
+}
+
+// Test case for the rows of some cities computed between removals and the others computed late
+TEST_F(HopDistanceTableTest, LazyRowsAfterRemoveVertex) {
+	BuildRandomGraph(3);
+	BitAdjacency<HOP_CITY_COUNT> adjacency;
+	adjacency.Build(*graph);
+	table->Build(adjacency);
+
+	for (int removed = 0; removed < 30; ++removed) {
+		for (int source = removed % 3; source < HOP_CITY_COUNT; source += 3)
+			table->DistanceSum(source);
+
+		int city = static_cast<int>(generator() % HOP_CITY_COUNT);
+		table->RemoveVertex(city);
+		RemoveFromGraph(city);
+	}
+
+	ExpectSameAsPlainBfs();
+}
+
+// Test case for the prepared closeness scores following the removed cities, and a second Prepare
+// replacing the table of the first graph
+TEST_F(HopDistanceTableTest, ClosenessFollowsPreparedGraph) {
+	std::unique_ptr<ClosenessCentrality<int, HOP_CITY_COUNT>> closeness(new ClosenessCentrality<int, HOP_CITY_COUNT>());
+	bool visited[HOP_CITY_COUNT] = { false };
+
+	BuildRandomGraph(4);
+	closeness->Prepare(*graph);
+
+	for (int removed = 0; removed < 20; ++removed) {
+		int city = static_cast<int>(generator() % HOP_CITY_COUNT);
+		closeness->RemoveVertex(city);
+		RemoveFromGraph(city);
+
+		for (int i = 0; i < HOP_CITY_COUNT; ++i)
+			ASSERT_EQ(closeness->Score(i, *graph, visited), 1.0 / PlainDistanceSum(i)) << "at " << i;
+	}
+
+	BuildRandomGraph(6);
+	closeness->Prepare(*graph);
+	for (int i = 0; i < HOP_CITY_COUNT; ++i)
+		ASSERT_EQ(closeness->Score(i, *graph, visited), 1.0 / PlainDistanceSum(i)) << "at " << i;
+}
+
+void RunHopDistanceTableTests() {
+	::testing::InitGoogleTest();
+	RUN_ALL_TESTS();
+}
@@ -0,0 +1,160 @@
+#include <IncrementalPath.h>
+#include <GeneticAlgorithm.cpp>
+#include <gtest/gtest.h>
+#include <random>
+
+// More than two words of edge bits so the shifts of Insert and Erase cross word boundaries
+const int PATH_CITY_COUNT = 150;
+
+class IncrementalPathTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		generator.seed(23);
+
+		// Dense band so long valid prefixes happen next to pairs outside the band
+		for (int i = 0; i < PATH_CITY_COUNT; ++i) {
+			for (int j = i + 1; j < PATH_CITY_COUNT; ++j) {
+				if (generator() % 10 != 0)
+					band.AddEdge(i, j);
+			}
+		}
+	}
+
+	int RandomCity() {
+		return static_cast<int>(generator() % PATH_CITY_COUNT);
+	}
+
+	// Fitness, valid prefix and count of pairs outside the band have to be the ones of a full rescan of the genes
+	void ExpectSameAsRescan(const IncrementalPath<int, PATH_CITY_COUNT>& path) {
+		int length = path.GetLength();
+		ASSERT_EQ(path.GetFitness(), CalculateFitness(genes, length, band));
+
+		int prefix = length;
+		int invalidCount = 0;
+		for (int i = 0; i < length - 1; ++i) {
+			if (!band.HasEdge(genes[i], genes[i + 1])) {
+				if (invalidCount == 0)
+					prefix = i + 1;
+				invalidCount++;
+			}
+		}
+		ASSERT_EQ(path.GetValidPrefixLength(), prefix);
+		ASSERT_EQ(path.GetInvalidCount(), invalidCount);
+	}
+
+	// Path of valid pairs, a random walk on the band
+	int BuildValidPath(int length) {
+		genes[0] = RandomCity();
+		for (int i = 1; i < length; ++i) {
+			do {
+				genes[i] = RandomCity();
+			} while (!band.HasEdge(genes[i - 1], genes[i]));
+		}
+		return length;
+	}
+
+	std::mt19937 generator;
+	BitAdjacency<PATH_CITY_COUNT> band;
+	int genes[PATH_CITY_COUNT];
+};
+
+// Test case for the cached state after Attach
+TEST_F(IncrementalPathTest, AttachMatchesRescan) {
+	IncrementalPath<int, PATH_CITY_COUNT> path;
+
+	int length = BuildValidPath(100);
+	path.Attach(band, genes, length);
+	EXPECT_EQ(path.GetFitness(), length - 1);
+	EXPECT_EQ(path.GetValidPrefixLength(), length);
+
+	for (int i = 0; i < 100; ++i)
+		genes[i] = RandomCity();
+	path.Attach(band, genes, 100);
+	ExpectSameAsRescan(path);
+}
+
+// Test case for empty and single gene paths
+TEST_F(IncrementalPathTest, ShortPaths) {
+	IncrementalPath<int, PATH_CITY_COUNT> path;
+
+	path.Attach(band, genes, 0);
+	EXPECT_EQ(path.GetFitness(), 0);
+	EXPECT_EQ(path.GetValidPrefixLength(), 0);
+
+	path.Insert(0, RandomCity());
+	ExpectSameAsRescan(path);
+	EXPECT_EQ(path.GetFitness(), 0);
+
+	path.Erase(0);
+	ExpectSameAsRescan(path);
+	EXPECT_EQ(path.GetLength(), 0);
+}
+
+// Test case for random swaps
+TEST_F(IncrementalPathTest, SwapsMatchRescan) {
+	IncrementalPath<int, PATH_CITY_COUNT> path;
+	int length = BuildValidPath(120);
+	path.Attach(band, genes, length);
+
+	for (int i = 0; i < 2000; ++i) {
+		path.Swap(static_cast<int>(generator() % length), static_cast<int>(generator() % length));
+		ExpectSameAsRescan(path);
+	}
+
+	// Ends and neighbors of each other
+	path.Swap(0, length - 1);
+	ExpectSameAsRescan(path);
+	path.Swap(0, 1);
+	ExpectSameAsRescan(path);
+	path.Swap(length - 1, length - 2);
+	ExpectSameAsRescan(path);
+}
+
+// Test case for inserts at the front, at the end and in the middle
+TEST_F(IncrementalPathTest, InsertsMatchRescan) {
+	IncrementalPath<int, PATH_CITY_COUNT> path;
+	int length = BuildValidPath(10);
+	path.Attach(band, genes, length);
+
+	path.Insert(0, RandomCity());
+	ExpectSameAsRescan(path);
+	path.Insert(path.GetLength(), RandomCity());
+	ExpectSameAsRescan(path);
+
+	while (path.GetLength() < PATH_CITY_COUNT - 1) {
+		path.Insert(static_cast<int>(generator() % (path.GetLength() + 1)), RandomCity());
+		ExpectSameAsRescan(path);
+	}
+}
+
+// Test case for swaps, inserts and erases mixed, with a valid path rebuilt now and then
+TEST_F(IncrementalPathTest, MixedEditsMatchRescan) {
+	IncrementalPath<int, PATH_CITY_COUNT> path;
+
+	for (int round = 0; round < 20; ++round) {
+		path.Attach(band, genes, BuildValidPath(1 + static_cast<int>(generator() % 100)));
+
+		for (int i = 0; i < 300; ++i) {
+			int length = path.GetLength();
+			int operation = static_cast<int>(generator() % 3);
+
+			if (operation == 0 && length > 0)
+				path.Swap(static_cast<int>(generator() % length), static_cast<int>(generator() % length));
+			else if (operation == 1 && length < PATH_CITY_COUNT - 1) {
+				int position = static_cast<int>(generator() % 4 == 0 ? (generator() % 2) * length : generator() % (length + 1));
+				path.Insert(position, RandomCity());
+			}
+			else if (length > 0) {
+				int position = static_cast<int>(generator() % 4 == 0 ? (generator() % 2) * (length - 1) : generator() % length);
+				path.Erase(position);
+			}
+
+			ExpectSameAsRescan(path);
+		}
+	}
+}
+
+void RunIncrementalPathTests() {
+	::testing::InitGoogleTest();
+	RUN_ALL_TESTS();
+}
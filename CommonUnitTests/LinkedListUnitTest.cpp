@@ -198,6 +198,104 @@ TEST_F(LinkedListTest, ClearTest) {
 	EXPECT_EQ(linkedList.GetSize(), 0);
 }
 
+// Test case for PopFront removing the elements in order
+TEST_F(LinkedListTest, PopFrontCorrectValue) {
+	LinkedList<int, 5> linkedList;
+
+	linkedList.PushBack(1);
+	linkedList.PushBack(2);
+	linkedList.PushBack(3);
+
+	EXPECT_TRUE(linkedList.PopFront());
+	EXPECT_EQ(linkedList.Front(), 2);
+	EXPECT_TRUE(linkedList.PopFront());
+	EXPECT_EQ(linkedList.Front(), 3);
+	EXPECT_EQ(linkedList.Back(), 3);
+	EXPECT_TRUE(linkedList.PopFront());
+	EXPECT_EQ(linkedList.GetSize(), 0);
+	EXPECT_FALSE(linkedList.PopFront());
+}
+
+// Test case for popped and cleared nodes going back to the pool
+TEST_F(LinkedListTest, PopAndClearReturnCapacity) {
+	LinkedList<int, 3> linkedList;
+
+	for (int i = 0; i < 100; ++i) {
+		EXPECT_TRUE(linkedList.PushBack(i));
+		EXPECT_TRUE(linkedList.PushBack(i + 1));
+		EXPECT_TRUE(linkedList.PopBack());
+		EXPECT_TRUE(linkedList.PopFront());
+	}
+
+	linkedList.PushBack(1);
+	linkedList.PushBack(2);
+	linkedList.PushBack(3);
+	linkedList.Clear();
+
+	EXPECT_TRUE(linkedList.PushBack(4));
+	EXPECT_TRUE(linkedList.PushBack(5));
+	EXPECT_TRUE(linkedList.PushBack(6));
+	EXPECT_FALSE(linkedList.PushBack(7));
+}
+
+// Test case for Insert into an empty list setting both ends
+TEST_F(LinkedListTest, InsertIntoEmpty) {
+	LinkedList<int, 5> linkedList;
+
+	EXPECT_TRUE(linkedList.Insert(linkedList.GetIterator(), 7));
+	EXPECT_EQ(linkedList.Front(), 7);
+	EXPECT_EQ(linkedList.Back(), 7);
+
+	EXPECT_TRUE(linkedList.PushBack(8));
+	EXPECT_EQ(linkedList.Back(), 8);
+}
+
+// Test case for Insert and Erase in the middle keeping both directions linked
+TEST_F(LinkedListTest, InsertEraseMiddleBackward) {
+	LinkedList<int, 5> linkedList;
+
+	linkedList.PushBack(1);
+	linkedList.PushBack(3);
+	linkedList.PushBack(4);
+
+	LinkedListIterator<int, 5> linkedListIterator = linkedList.GetIterator();
+	linkedListIterator.Next();
+	linkedList.Insert(linkedListIterator, 2); // 1 2 3 4, the iterator stays at 3
+
+	EXPECT_TRUE(linkedList.Erase(linkedListIterator)); // 1 2 4, iterator moves back to 2
+	EXPECT_EQ(linkedListIterator.Next(), 2);
+
+	linkedListIterator = linkedList.GetIterator();
+	while (linkedListIterator.HasNext())
+		linkedListIterator.Next();
+
+	EXPECT_EQ(linkedListIterator.Prev(), 4);
+	EXPECT_EQ(linkedListIterator.Prev(), 2);
+	EXPECT_EQ(linkedListIterator.Prev(), 1);
+	EXPECT_FALSE(linkedListIterator.HasPrev());
+	EXPECT_EQ(linkedList.GetSize(), 3);
+}
+
+// Test case for Prev from the end seeing an element pushed after the iterator was made
+TEST_F(LinkedListTest, BackwardIteratorAfterPushBack) {
+	LinkedList<int, 5> linkedList;
+
+	linkedList.PushBack(1);
+	linkedList.PushBack(2);
+
+	LinkedListIterator<int, 5> linkedListIterator = linkedList.GetIterator();
+
+	linkedList.PushBack(3);
+
+	while (linkedListIterator.HasNext())
+		linkedListIterator.Next();
+
+	EXPECT_EQ(linkedListIterator.Prev(), 3);
+	EXPECT_EQ(linkedListIterator.Prev(), 2);
+	EXPECT_EQ(linkedListIterator.Prev(), 1);
+	EXPECT_FALSE(linkedListIterator.HasPrev());
+}
+
 void RunLinkedListTests() {
 	::testing::InitGoogleTest();
 	RUN_ALL_TESTS();
@@ -0,0 +1,107 @@
+#include <MappedFile.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+class MappedFileTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		fileName = "MappedFileUnitTest.tmp";
+	}
+
+	void TearDown() override {
+		std::remove(fileName.c_str());
+	}
+
+	void WriteFile(const std::string& content) {
+		std::ofstream file(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+		file.write(content.data(), content.size());
+	}
+
+	std::string fileName;
+};
+
+// Test case for the mapped bytes being the file content
+TEST_F(MappedFileTest, MapsFileContent) {
+	std::string content = "01;ADANA;0;338\r\n02;ADIYAMAN;335;0\r\n";
+	WriteFile(content);
+
+	MappedFile file;
+	ASSERT_TRUE(file.Open(fileName));
+	EXPECT_TRUE(file.IsOpen());
+	ASSERT_EQ(file.GetSize(), content.size());
+	EXPECT_EQ(std::string(file.GetData(), file.GetSize()), content);
+}
+
+// Test case for bytes that are not valid text, like the Windows-1254 header of ilmesafe.csv
+TEST_F(MappedFileTest, KeepsBytesAsTheyAre) {
+	std::string content = "\xDD\x4C\x20\x4D\x45\x53\x41\x46\x45\x00\xFF";
+	WriteFile(content);
+
+	MappedFile file;
+	ASSERT_TRUE(file.Open(fileName));
+	ASSERT_EQ(file.GetSize(), content.size());
+	EXPECT_EQ(std::string(file.GetData(), file.GetSize()), content);
+}
+
+// Test case for an empty file
+TEST_F(MappedFileTest, EmptyFile) {
+	WriteFile("");
+
+	MappedFile file;
+	ASSERT_TRUE(file.Open(fileName));
+	EXPECT_EQ(file.GetSize(), 0u);
+	EXPECT_NE(file.GetData(), nullptr);
+}
+
+// Test case for a file that doesn't exist
+TEST_F(MappedFileTest, MissingFile) {
+	MappedFile file;
+
+	EXPECT_FALSE(file.Open("MappedFileUnitTest.missing"));
+	EXPECT_FALSE(file.IsOpen());
+	EXPECT_EQ(file.GetData(), nullptr);
+	EXPECT_EQ(file.GetSize(), 0u);
+}
+
+// Test case for closing and opening another file
+TEST_F(MappedFileTest, CloseAndReopen) {
+	WriteFile("first");
+
+	MappedFile file;
+	ASSERT_TRUE(file.Open(fileName));
+	file.Close();
+	EXPECT_FALSE(file.IsOpen());
+	EXPECT_EQ(file.GetSize(), 0u);
+
+	WriteFile("second file");
+	ASSERT_TRUE(file.Open(fileName));
+	EXPECT_EQ(std::string(file.GetData(), file.GetSize()), "second file");
+}
+
+// Test case for the stamp following the size of the file
+TEST_F(MappedFileTest, FileStamp) {
+	WriteFile("first");
+
+	FileStamp first;
+	ASSERT_TRUE(GetFileStamp(fileName, first));
+	EXPECT_EQ(first.size, 5u);
+
+	FileStamp again;
+	ASSERT_TRUE(GetFileStamp(fileName, again));
+	EXPECT_EQ(again.size, first.size);
+	EXPECT_EQ(again.modified, first.modified);
+
+	WriteFile("second file");
+	FileStamp second;
+	ASSERT_TRUE(GetFileStamp(fileName, second));
+	EXPECT_EQ(second.size, 11u);
+
+	EXPECT_FALSE(GetFileStamp("MappedFileUnitTest.missing", second));
+}
+
+void RunMappedFileTests() {
+	::testing::InitGoogleTest();
+	RUN_ALL_TESTS();
+}
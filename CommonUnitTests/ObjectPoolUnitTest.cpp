@@ -0,0 +1,87 @@
+#include <ObjectPool.h>
+#include <gtest/gtest.h>
+
+class ObjectPoolTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+// Test case for Allocate until the pool is out of capacity
+TEST_F(ObjectPoolTest, AllocateExceedingCapacity) {
+	ObjectPool<int, 3> objectPool;
+
+	EXPECT_NE(objectPool.Allocate(), nullptr);
+	EXPECT_NE(objectPool.Allocate(), nullptr);
+	EXPECT_NE(objectPool.Allocate(), nullptr);
+	EXPECT_EQ(objectPool.Allocate(), nullptr); // Should fail since out of capacity
+	EXPECT_EQ(objectPool.GetUsedCount(), 3);
+}
+
+// Test case for Allocate returning distinct slots
+TEST_F(ObjectPoolTest, AllocateDistinctObjects) {
+	ObjectPool<int, 3> objectPool;
+
+	int* first = objectPool.Allocate();
+	int* second = objectPool.Allocate();
+	int* third = objectPool.Allocate();
+
+	EXPECT_NE(first, second);
+	EXPECT_NE(second, third);
+	EXPECT_NE(first, third);
+}
+
+// Test case for Free making the slot available again
+TEST_F(ObjectPoolTest, FreeAndReuse) {
+	ObjectPool<int, 2> objectPool;
+
+	int* first = objectPool.Allocate();
+	objectPool.Allocate();
+
+	EXPECT_TRUE(objectPool.Free(first));
+	EXPECT_EQ(objectPool.GetUsedCount(), 1);
+	EXPECT_EQ(objectPool.Allocate(), first); // Last freed slot is reused first
+	EXPECT_EQ(objectPool.Allocate(), nullptr);
+}
+
+// Test case for Free with an object that doesn't belong to the pool
+TEST_F(ObjectPoolTest, FreeOutsideObject) {
+	ObjectPool<int, 2> objectPool;
+	int outsideObject = 0;
+
+	objectPool.Allocate();
+
+	EXPECT_FALSE(objectPool.Free(&outsideObject));
+	EXPECT_FALSE(objectPool.Free(nullptr));
+	EXPECT_EQ(objectPool.GetUsedCount(), 1);
+}
+
+// Test case for freeing the same object twice
+TEST_F(ObjectPoolTest, DoubleFree) {
+	ObjectPool<int, 2> objectPool;
+
+	int* first = objectPool.Allocate();
+
+	EXPECT_TRUE(objectPool.Free(first));
+	EXPECT_FALSE(objectPool.Free(first));
+	EXPECT_EQ(objectPool.GetUsedCount(), 0);
+}
+
+// Test case for a pointer inside a slot but not at its start
+TEST_F(ObjectPoolTest, FreeMisalignedPointer) {
+	ObjectPool<long long, 2> objectPool;
+
+	long long* first = objectPool.Allocate();
+	char* inside = reinterpret_cast<char*>(first) + 1;
+
+	EXPECT_FALSE(objectPool.Owns(reinterpret_cast<long long*>(inside)));
+	EXPECT_TRUE(objectPool.Owns(first));
+}
+
+void RunObjectPoolTests() {
+	::testing::InitGoogleTest();
+	RUN_ALL_TESTS();
+}
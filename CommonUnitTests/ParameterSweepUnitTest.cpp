@@ -0,0 +1,124 @@
+#include <ParameterSweep.cpp>
+#include <IncrementalBandGraph.h>
+#include <WorkStealingThreadPool.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+
+typedef StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT> DistanceMatrix;
+
+class ParameterSweepTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		distances.reset(new DistanceMatrix());
+		expected.reset(new DistanceMatrix());
+		cityPairs.reset(new SortedCityPairs<CITY_COUNT>());
+
+		// Symmetric table like ilmesafe.csv with a few missing distances
+		std::mt19937 generator(17);
+		std::uniform_int_distribution<int> distance(1, 450);
+		for (int i = 0; i < CITY_COUNT; ++i) {
+			(*distances)[i][i] = 0;
+			for (int j = i + 1; j < CITY_COUNT; ++j) {
+				int value = (generator() % 20 == 0) ? 0 : distance(generator);
+				(*distances)[i][j] = value;
+				(*distances)[j][i] = value;
+			}
+		}
+
+		cityPairs->Build(*distances);
+	}
+
+	// The band graph has to hold the same edges as CreateGraph, in the matrix and in the bit rows
+	void ExpectSameAsCreateGraph(IncrementalBandGraph<CITY_COUNT>& bandGraph, int distance, int tolerance) {
+		CreateGraph(*distances, *expected, distance, tolerance);
+
+		BitAdjacency<CITY_COUNT> expectedAdjacency;
+		expectedAdjacency.Build(*expected);
+
+		for (int i = 0; i < CITY_COUNT; ++i) {
+			for (int j = 0; j < CITY_COUNT; ++j)
+				ASSERT_EQ(bandGraph.GetGraph()[i][j], (*expected)[i][j]) << distance << ", " << tolerance << " at " << i << ", " << j;
+
+			ASSERT_TRUE(bandGraph.GetAdjacency().Row(i) == expectedAdjacency.Row(i)) << distance << ", " << tolerance << " at row " << i;
+		}
+	}
+
+	std::unique_ptr<DistanceMatrix> distances;
+	std::unique_ptr<DistanceMatrix> expected;
+	std::unique_ptr<SortedCityPairs<CITY_COUNT>> cityPairs;
+};
+
+// Test case for the band walk of the sweep, rows of shrinking tolerances with the distance decreasing between rows
+TEST_F(ParameterSweepTest, BandWalkMatchesCreateGraph) {
+	std::unique_ptr<IncrementalBandGraph<CITY_COUNT>> bandGraph(new IncrementalBandGraph<CITY_COUNT>(*cityPairs));
+
+	for (int distance = 220; distance >= 180; distance -= 7) {
+		for (int tolerance = 50; tolerance >= 1; tolerance -= 3) {
+			bandGraph->SetBand(distance - tolerance, distance + tolerance);
+			ExpectSameAsCreateGraph(*bandGraph, distance, tolerance);
+		}
+	}
+}
+
+// Test case for bands which don't overlap the previous one, growing bands and an empty band
+TEST_F(ParameterSweepTest, BandJumpsMatchCreateGraph) {
+	std::unique_ptr<IncrementalBandGraph<CITY_COUNT>> bandGraph(new IncrementalBandGraph<CITY_COUNT>(*cityPairs));
+	const int bands[][2] = { { 100, 10 }, { 400, 20 }, { 50, 5 }, { 50, 40 }, { 300, 0 }, { 600, 10 }, { 200, 200 }, { 1, 1 } };
+
+	for (size_t i = 0; i < sizeof(bands) / sizeof(bands[0]); ++i) {
+		bandGraph->SetBand(bands[i][0] - bands[i][1], bands[i][0] + bands[i][1]);
+		ExpectSameAsCreateGraph(*bandGraph, bands[i][0], bands[i][1]);
+	}
+}
+
+// Test case for the search on bit rows finding the same paths as the search on the matrix
+TEST_F(ParameterSweepTest, MaskedSearchMatchesMatrixSearch) {
+	std::unique_ptr<IncrementalBandGraph<CITY_COUNT>> bandGraph(new IncrementalBandGraph<CITY_COUNT>(*cityPairs));
+	std::unique_ptr<CombinationScorer> scorer(new CombinationScorer());
+	bandGraph->SetBand(150, 250);
+
+	for (int city = 0; city < CITY_COUNT; city += 4) {
+		bool visited[CITY_COUNT] = { false };
+		CreateGraph(*distances, *expected, 200, 50);
+		int expectedCount = FindLongestPathComposed(*expected, visited, city, -1, *scorer);
+
+		bool maskedVisited[CITY_COUNT] = { false };
+		int count = FindLongestPathComposedMasked(bandGraph->GetAdjacency(), bandGraph->GetGraph(), maskedVisited, city, *scorer);
+
+		EXPECT_EQ(count, expectedCount) << "from " << city;
+		for (int i = 0; i < CITY_COUNT; ++i)
+			EXPECT_EQ(maskedVisited[i], visited[i]) << "from " << city << " at " << i;
+	}
+
+	ExpectSameAsCreateGraph(*bandGraph, 200, 50); // The search doesn't modify the band graph
+}
+
+// Test case for the incremental sweep giving the score of every config of the parallel sweep
+TEST_F(ParameterSweepTest, IncrementalSweepMatchesParallelSweep) {
+	WorkStealingThreadPool pool(3);
+	SweepGrid grid;
+	grid.maxDistance = 220;
+	grid.minDistance = 170;
+	grid.maxTolerance = 50;
+	grid.minTolerance = 35;
+
+	SweepResult parallel = FindMinimumDistanceToleranceParallel(*distances, pool, grid);
+	SweepResult incremental = FindMinimumDistanceToleranceIncremental(*distances, pool, grid);
+
+	ASSERT_EQ(incremental.configs.size(), parallel.configs.size());
+	for (size_t i = 0; i < parallel.configs.size(); ++i) {
+		EXPECT_EQ(incremental.configs[i].distance, parallel.configs[i].distance);
+		EXPECT_EQ(incremental.configs[i].tolerance, parallel.configs[i].tolerance);
+		EXPECT_EQ(incremental.configs[i].score, parallel.configs[i].score) << "config " << i;
+	}
+
+	EXPECT_EQ(incremental.bestDistance, parallel.bestDistance);
+	EXPECT_EQ(incremental.bestTolerance, parallel.bestTolerance);
+	EXPECT_EQ(incremental.bestScore, parallel.bestScore);
+}
+
+void RunParameterSweepTests() {
+	::testing::InitGoogleTest();
+	RUN_ALL_TESTS();
+}
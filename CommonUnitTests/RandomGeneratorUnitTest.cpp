@@ -0,0 +1,124 @@
+#include <RandomGenerator.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+class RandomGeneratorTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+// Test case for the sequence of a seed not changing between platforms and versions
+TEST_F(RandomGeneratorTest, KnownSequence) {
+	RandomGenerator random(12345);
+
+	EXPECT_EQ(random.Next(), 0xBE6A36374160D49BULL);
+	EXPECT_EQ(random.Next(), 0x214AAA0637A688C6ULL);
+	EXPECT_EQ(random.Next(), 0xF69D16DE9954D388ULL);
+}
+
+// Test case for the same seed giving the same numbers and Seed restarting the sequence
+TEST_F(RandomGeneratorTest, SameSeedSameSequence) {
+	RandomGenerator first(42);
+	RandomGenerator second(42);
+	std::vector<uint64_t> values;
+
+	for (int i = 0; i < 100; ++i) {
+		values.push_back(first.Next());
+		EXPECT_EQ(values.back(), second.Next());
+	}
+
+	first.Seed(42);
+	for (int i = 0; i < 100; ++i)
+		EXPECT_EQ(first.Next(), values[i]);
+}
+
+// Test case for close seeds giving different sequences
+TEST_F(RandomGeneratorTest, DifferentSeedsDiffer) {
+	RandomGenerator first(1);
+	RandomGenerator second(2);
+	int equalCount = 0;
+
+	for (int i = 0; i < 100; ++i) {
+		if (first.Next() == second.Next())
+			equalCount++;
+	}
+
+	EXPECT_EQ(equalCount, 0);
+}
+
+// Test case for NextInt staying in [start, end) and returning every value of a small range
+TEST_F(RandomGeneratorTest, NextIntRange) {
+	RandomGenerator random(7);
+	int counts[10] = { 0 };
+
+	for (int i = 0; i < 10000; ++i) {
+		int value = random.NextInt(5, 15);
+		ASSERT_GE(value, 5);
+		ASSERT_LT(value, 15);
+		counts[value - 5]++;
+	}
+
+	for (int i = 0; i < 10; ++i) { // 1000 expected for every value
+		EXPECT_GT(counts[i], 850);
+		EXPECT_LT(counts[i], 1150);
+	}
+
+	EXPECT_EQ(random.NextInt(3, 4), 3);
+	EXPECT_LT(random.NextInt(-10, -5), -5);
+}
+
+// Test case for NextDouble staying in [0, 1)
+TEST_F(RandomGeneratorTest, NextDoubleRange) {
+	RandomGenerator random(9);
+	double sum = 0;
+
+	for (int i = 0; i < 10000; ++i) {
+		double value = random.NextDouble();
+		ASSERT_GE(value, 0.0);
+		ASSERT_LT(value, 1.0);
+		sum += value;
+	}
+
+	EXPECT_NEAR(sum / 10000, 0.5, 0.02);
+}
+
+// Test case for jumped generators giving different streams from one seed
+TEST_F(RandomGeneratorTest, JumpGivesAnotherStream) {
+	RandomGenerator first(100);
+	RandomGenerator second(100);
+	second.Jump();
+
+	int equalCount = 0;
+	for (int i = 0; i < 100; ++i) {
+		if (first.Next() == second.Next())
+			equalCount++;
+	}
+
+	EXPECT_EQ(equalCount, 0);
+}
+
+// Test case for using the generator with the standard algorithms
+TEST_F(RandomGeneratorTest, WorksWithShuffle) {
+	RandomGenerator random(3);
+	std::vector<int> values;
+
+	for (int i = 0; i < 50; ++i)
+		values.push_back(i);
+
+	std::shuffle(values.begin(), values.end(), random);
+	std::vector<int> sorted = values;
+	std::sort(sorted.begin(), sorted.end());
+
+	for (int i = 0; i < 50; ++i)
+		EXPECT_EQ(sorted[i], i);
+}
+
+void RunRandomGeneratorTests() {
+	::testing::InitGoogleTest();
+	RUN_ALL_TESTS();
+}
@@ -0,0 +1,133 @@
+#include <StaticBitsetLibrary.h>
+#include <gtest/gtest.h>
+
+class StaticBitsetTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+// Test case for Set, Test and Reset across word boundaries
+TEST_F(StaticBitsetTest, SetTestAndReset) {
+	StaticBitset<81> bitset;
+
+	bitset.Set(0);
+	bitset.Set(63);
+	bitset.Set(64);
+	bitset.Set(80);
+
+	EXPECT_TRUE(bitset.Test(0));
+	EXPECT_TRUE(bitset.Test(63));
+	EXPECT_TRUE(bitset.Test(64));
+	EXPECT_TRUE(bitset.Test(80));
+	EXPECT_FALSE(bitset.Test(1));
+
+	bitset.Reset(63);
+	EXPECT_FALSE(bitset.Test(63));
+	EXPECT_EQ(bitset.Count(), 3);
+}
+
+// Test case for SetAll not setting bits past the size
+TEST_F(StaticBitsetTest, SetAllAndCount) {
+	StaticBitset<81> bitset;
+
+	bitset.SetAll();
+	EXPECT_EQ(bitset.Count(), 81);
+
+	bitset.Clear();
+	EXPECT_EQ(bitset.Count(), 0);
+	EXPECT_FALSE(bitset.Any());
+}
+
+// Test case for popcount of row & ~mask
+TEST_F(StaticBitsetTest, CountAndNot) {
+	StaticBitset<81> row;
+	StaticBitset<81> visited;
+
+	row.Set(2);
+	row.Set(40);
+	row.Set(70);
+	visited.Set(40);
+	visited.Set(5);
+
+	EXPECT_EQ(row.CountAndNot(visited), 2);
+}
+
+// Test case for clearing the bits of another bitset
+TEST_F(StaticBitsetTest, AndNot) {
+	StaticBitset<81> bitset;
+	StaticBitset<81> mask;
+
+	bitset.Set(1);
+	bitset.Set(70);
+	mask.Set(70);
+	bitset.AndNot(mask);
+
+	EXPECT_TRUE(bitset.Test(1));
+	EXPECT_FALSE(bitset.Test(70));
+	EXPECT_TRUE(mask.Test(70));
+}
+
+// Test case for complement keeping the count inside the size
+TEST_F(StaticBitsetTest, Complement) {
+	StaticBitset<81> bitset;
+
+	bitset.Set(3);
+	StaticBitset<81> complement = ~bitset;
+
+	EXPECT_EQ(complement.Count(), 80);
+	EXPECT_FALSE(complement.Test(3));
+}
+
+// Test case for iterating the set bits in order
+TEST_F(StaticBitsetTest, FindFirstAndNext) {
+	StaticBitset<130> bitset;
+	int expected[] = { 1, 63, 64, 129 };
+
+	for (int i = 0; i < 4; ++i)
+		bitset.Set(expected[i]);
+
+	int i = 0;
+	for (int index = bitset.FindFirst(); index != -1; index = bitset.FindNext(index)) {
+		EXPECT_EQ(index, expected[i]);
+		i++;
+	}
+
+	EXPECT_EQ(i, 4);
+}
+
+// Test case for FindFirst of an empty bitset
+TEST_F(StaticBitsetTest, FindFirstEmpty) {
+	StaticBitset<10> bitset;
+
+	EXPECT_EQ(bitset.FindFirst(), -1);
+	bitset.Set(9);
+	EXPECT_EQ(bitset.FindNext(9), -1);
+}
+
+// Test case for Select returning the set bits by rank across words
+TEST_F(StaticBitsetTest, Select) {
+	StaticBitset<130> bitset;
+	int expected[] = { 0, 5, 63, 64, 100, 129 };
+
+	for (int i = 0; i < 6; ++i)
+		bitset.Set(expected[i]);
+
+	for (int i = 0; i < 6; ++i)
+		EXPECT_EQ(bitset.Select(i), expected[i]);
+
+	EXPECT_EQ(bitset.Select(6), -1);
+
+	StaticBitset<130> complement = ~bitset;
+	EXPECT_EQ(complement.Select(0), 1);
+	EXPECT_EQ(complement.Select(4), 6);
+	EXPECT_EQ(complement.Select(complement.Count() - 1), 128);
+}
+
+void RunStaticBitsetTests() {
+	::testing::InitGoogleTest();
+	RUN_ALL_TESTS();
+}
@@ -0,0 +1,93 @@
+#include <StaticRingQueue.h>
+#include <gtest/gtest.h>
+#include <deque>
+
+class StaticRingQueueTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+// Test case for elements leaving in the order they were pushed
+TEST_F(StaticRingQueueTest, PushAndPopInOrder) {
+	StaticRingQueue<int, 5> queue;
+
+	EXPECT_TRUE(queue.IsEmpty());
+	EXPECT_TRUE(queue.Push(1));
+	EXPECT_TRUE(queue.Push(2));
+	EXPECT_TRUE(queue.Push(3));
+	EXPECT_EQ(queue.GetSize(), 3);
+	EXPECT_EQ(queue.Front(), 1);
+	EXPECT_EQ(queue.Back(), 3);
+
+	EXPECT_TRUE(queue.Pop());
+	EXPECT_EQ(queue.Front(), 2);
+	EXPECT_TRUE(queue.Pop());
+	EXPECT_EQ(queue.Front(), 3);
+	EXPECT_TRUE(queue.Pop());
+	EXPECT_TRUE(queue.IsEmpty());
+}
+
+// Test case for Push exceeding capacity and Pop on an empty queue
+TEST_F(StaticRingQueueTest, PushExceedingCapacity) {
+	StaticRingQueue<int, 2> queue;  // Capacity set to 2
+
+	EXPECT_FALSE(queue.Pop());
+	EXPECT_TRUE(queue.Push(1));
+	EXPECT_TRUE(queue.Push(2));
+	EXPECT_TRUE(queue.IsFull());
+	EXPECT_FALSE(queue.Push(3));  // Should fail since out of capacity
+	EXPECT_EQ(queue.GetSize(), 2);
+	EXPECT_EQ(queue.Back(), 2);
+}
+
+// Test case for the head and the tail wrapping around the array many times
+TEST_F(StaticRingQueueTest, WrapAround) {
+	StaticRingQueue<int, 4> queue;
+	std::deque<int> expected;
+	int next = 0;
+
+	for (int step = 0; step < 1000; ++step) {
+		if (step % 3 != 2 && !queue.IsFull()) {
+			EXPECT_TRUE(queue.Push(next));
+			expected.push_back(next++);
+		}
+		else if (!queue.IsEmpty()) {
+			EXPECT_EQ(queue.Front(), expected.front());
+			EXPECT_TRUE(queue.Pop());
+			expected.pop_front();
+		}
+
+		ASSERT_EQ(queue.GetSize(), static_cast<int>(expected.size()));
+		if (!expected.empty()) {
+			EXPECT_EQ(queue.Front(), expected.front());
+			EXPECT_EQ(queue.Back(), expected.back());
+		}
+	}
+}
+
+// Test case for Clear emptying the queue and the full capacity being usable after it
+TEST_F(StaticRingQueueTest, Clear) {
+	StaticRingQueue<int, 3> queue;
+
+	queue.Push(1);
+	queue.Push(2);
+	queue.Pop();
+	queue.Clear();
+
+	EXPECT_TRUE(queue.IsEmpty());
+	EXPECT_TRUE(queue.Push(4));
+	EXPECT_TRUE(queue.Push(5));
+	EXPECT_TRUE(queue.Push(6));
+	EXPECT_FALSE(queue.Push(7));
+	EXPECT_EQ(queue.Front(), 4);
+	EXPECT_EQ(queue.Back(), 6);
+}
+
+void RunStaticRingQueueTests() {
+	::testing::InitGoogleTest();
+	RUN_ALL_TESTS();
+}
@@ -0,0 +1,80 @@
+#include <WorkStealingThreadPool.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+
+class WorkStealingThreadPoolTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+// Test case for every index being processed exactly once
+TEST_F(WorkStealingThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+	WorkStealingThreadPool threadPool(4);
+	std::vector<std::atomic<int>> visitCounts(1000);
+
+	for (size_t i = 0; i < visitCounts.size(); ++i)
+		visitCounts[i] = 0;
+
+	threadPool.ParallelFor(1000, [&](int index, int) {
+		visitCounts[index]++;
+	});
+
+	for (size_t i = 0; i < visitCounts.size(); ++i)
+		EXPECT_EQ(visitCounts[i], 1);
+}
+
+// Test case for worker indices being inside the thread count
+TEST_F(WorkStealingThreadPoolTest, WorkerIndexInRange) {
+	WorkStealingThreadPool threadPool(3);
+	std::atomic<int> outOfRange(0);
+
+	threadPool.ParallelFor(100, [&](int, int worker) {
+		if (worker < 0 || worker >= threadPool.GetThreadCount())
+			outOfRange++;
+	});
+
+	EXPECT_EQ(outOfRange, 0);
+}
+
+// Test case for uneven work, slow indices are all at the start of the first worker's range
+TEST_F(WorkStealingThreadPoolTest, UnevenWorkIsStolen) {
+	WorkStealingThreadPool threadPool(4);
+	std::atomic<int> processed(0);
+	std::atomic<int> processedByOthers(0);
+
+	threadPool.ParallelFor(64, [&](int index, int worker) {
+		if (index < 16)
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+		if (index < 16 && worker != 0)
+			processedByOthers++;
+		processed++;
+	});
+
+	EXPECT_EQ(processed, 64);
+	EXPECT_GT(processedByOthers, 0);
+}
+
+// Test case for reusing the pool and an empty range
+TEST_F(WorkStealingThreadPoolTest, RepeatedCalls) {
+	WorkStealingThreadPool threadPool(2);
+	std::atomic<int> sum(0);
+
+	threadPool.ParallelFor(0, [&](int, int) { sum++; });
+	EXPECT_EQ(sum, 0);
+
+	for (int i = 0; i < 10; ++i)
+		threadPool.ParallelFor(10, [&](int index, int) { sum += index; });
+
+	EXPECT_EQ(sum, 450);
+}
+
+void RunWorkStealingThreadPoolTests() {
+	::testing::InitGoogleTest();
+	RUN_ALL_TESTS();
+}
@@ -1,35 +1,76 @@
 #pragma once
 
 #include<StaticVectorLibrary.h>
-#include<LinkedListLibrary.h>
+#include<StaticRingQueue.h>
+#include<StaticBitsetLibrary.h>
+#include<BitAdjacency.h>
+#include<HopDistanceTable.h>
+#include<WorkStealingThreadPool.h>
 
 template <class T, unsigned int N>
 class Algorithms {
 public:
 	virtual double Score(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]) = 0;
+
+	// Called when a search starts on graph, algorithms can build caches of the graph here.
+	// Scores are computed for that graph until the next Prepare, so once an algorithm was prepared
+	// every caller of Score has to call Prepare with its own graph first.
+	virtual void Prepare(StaticVector<StaticVector<T, N>, N>& graph) {}
+
+	// Called when the search removes every edge of a city from the prepared graph
+	virtual void RemoveVertex(T vertex) {}
 };
 
 template <class T, unsigned int N>
 class ClosenessCentrality : public Algorithms<T, N> {
 public:
+	ClosenessCentrality() : prepared(false) {}
+
 	double Score(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]);
+
+	// After Prepare scores are read from the hop distance table instead of running a BFS per call
+	void Prepare(StaticVector<StaticVector<T, N>, N>& graph);
+	void Prepare(const BitAdjacency<N>& graph);
+	void RemoveVertex(T vertex);
 private:
 	void ComputeClosenessCentrality(T start, StaticVector<StaticVector<T, N>, N>& graph, int distances[N]);
+
+	HopDistanceTable<N> distanceTable;
+	bool prepared;
 };
 
 
 template <class T, unsigned int N>
 class BetweennessCentrality : public Algorithms<T, N> {
 public:
+	BetweennessCentrality() : prepared(false), cacheValid(false), threadPool(NULL) {}
+
 	double Score(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]);
+
+	// After Prepare the scores of every city are computed once and kept until a city is removed
+	void Prepare(StaticVector<StaticVector<T, N>, N>& graph);
+	void Prepare(const BitAdjacency<N>& graph);
+	void RemoveVertex(T vertex);
+
+	// Splits the source cities over the pool, NULL computes on the calling thread
+	void SetThreadPool(WorkStealingThreadPool* pool) { threadPool = pool; }
 private:
-	int ComputeBetweennessCentrality(T node, T start, T end, StaticVector<StaticVector<T, N>, N>& graph);
+	// Brandes algorithm, O(N * E) for all cities
+	void ComputeBetweennessCentrality();
+	void AccumulateSource(int source, double* result) const;
+
+	BitAdjacency<N> adjacency;
+	double centrality[N];
+	bool prepared;
+	bool cacheValid;
+	WorkStealingThreadPool* threadPool;
 };
 
 template <class T, unsigned int N>
 class FirstOrderNeighbors : public Algorithms<T, N> {
 public:
 	double Score(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]);
+	double Score(T node, const BitAdjacency<N>& graph, const StaticBitset<N>& visited);
 
 };
 
@@ -37,6 +78,7 @@ template <class T, unsigned int N>
 class SecondOrderNeighbors : public Algorithms<T, N> {
 public:
 	double Score(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]);
+	double Score(T node, const BitAdjacency<N>& graph, const StaticBitset<N>& visited);
 private:
 	int FirstOrderNeighborScore(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]);
 };
@@ -45,81 +87,131 @@ template <class T, unsigned int N>
 class ThirdOrderNeighbors : public Algorithms<T, N> {
 public:
 	double Score(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]);
+	double Score(T node, const BitAdjacency<N>& graph, const StaticBitset<N>& visited);
 private:
 	int FirstOrderNeighborScore(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]);
 	int SecondOrderNeighborScore(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]);
+	int SecondOrderNeighborScore(T node, const BitAdjacency<N>& graph, const StaticBitset<N>& visited);
 };
 
 
+template <class T, unsigned int N>
+void BetweennessCentrality<T, N>::Prepare(StaticVector<StaticVector<T, N>, N>& graph) {
+	adjacency.Build(graph);
+	prepared = true;
+	cacheValid = false;
+}
+
+template <class T, unsigned int N>
+void BetweennessCentrality<T, N>::Prepare(const BitAdjacency<N>& graph) {
+	adjacency = graph;
+	prepared = true;
+	cacheValid = false;
+}
+
+template <class T, unsigned int N>
+void BetweennessCentrality<T, N>::RemoveVertex(T vertex) {
+	if (!prepared)
+		return;
+
+	adjacency.RemoveVertex(vertex);
+	cacheValid = false;
+}
+
+// Fraction of the shortest paths between other city pairs which pass through the node
 template <class T, unsigned int N>
 double BetweennessCentrality<T, N>::Score(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]) {
-	int betweenScore = 0;
-	int totalScore = 0;
-	for (int i = 0; i < N; ++i) {
-		for (int j = i; j < N; ++j) {
-			if (i == j)
-				continue;
-
-			int s = ComputeBetweennessCentrality(node, i, j, graph);
-			if (s == 1)
-				betweenScore += 1;
-			if (s != -1)
-				totalScore += 1;
-		}
+	if (!prepared) { // No cache without Prepare since the graph may change between calls
+		adjacency.Build(graph);
+		cacheValid = false;
 	}
 
-	if (totalScore == 0)
-		return 0.0;
+	if (!cacheValid) {
+		ComputeBetweennessCentrality();
+		cacheValid = prepared;
+	}
 
-	return static_cast<double>(betweenScore) / totalScore;
+	return centrality[node];
 }
 
 template <class T, unsigned int N>
-int BetweennessCentrality<T, N>::ComputeBetweennessCentrality(T node, T startNode, T endNode, StaticVector<StaticVector<T, N>, N>& graph) {
-	LinkedList<int, N> queue;
-	queue.PushBack(startNode);
-	bool visited[N] = { false };
-	int next[N] = { -1 };
+void BetweennessCentrality<T, N>::ComputeBetweennessCentrality() {
+	double pairCount = (N - 1.0) * (N - 2.0); // Ordered pairs of other cities, used to normalize the score
 
-	while (queue.GetSize() != 0) {
-		int currentCity = queue.Front();
-		queue.Erase(queue.GetIterator());
+	if (threadPool == NULL || threadPool->GetThreadCount() == 1) {
+		for (int i = 0; i < N; ++i)
+			centrality[i] = 0;
 
-		if (currentCity == endNode)
-			break;
+		for (int source = 0; source < N; ++source)
+			AccumulateSource(source, centrality);
+	}
+	else {
+		// Sources are independent, every worker sums its own dependencies and they are added at the end
+		int workerCount = threadPool->GetThreadCount();
+		std::vector<double> workerCentrality(workerCount * N, 0.0);
+
+		threadPool->ParallelFor(N, [&](int source, int worker) {
+			AccumulateSource(source, &workerCentrality[worker * N]);
+		});
+
+		for (int i = 0; i < N; ++i) {
+			centrality[i] = 0;
+			for (int worker = 0; worker < workerCount; ++worker)
+				centrality[i] += workerCentrality[worker * N + i];
+		}
+	}
 
-		if (!visited[currentCity]) {
-			for (int i = 0; i < N; ++i) {
-				if (graph[currentCity][i] && !visited[i]) {
-					queue.PushBack(i);
-					next[currentCity] = i;
-				}
-			}
+	for (int i = 0; i < N; ++i)
+		centrality[i] = (pairCount > 0) ? centrality[i] / pairCount : 0.0;
+}
 
-			visited[currentCity] = true;
-		}
+// Brandes: BFS from the source counts the shortest paths to every city, then the dependencies are
+// accumulated in reverse BFS order. A predecessor of w is a neighbor one level closer to the source.
+template <class T, unsigned int N>
+void BetweennessCentrality<T, N>::AccumulateSource(int source, double* result) const {
+	int order[N]; // BFS order, also used as the queue
+	int distances[N];
+	double pathCounts[N];
+	double dependencies[N];
+
+	for (int i = 0; i < N; ++i) {
+		distances[i] = -1;
+		pathCounts[i] = 0;
+		dependencies[i] = 0;
 	}
 
-	bool temp = false;
+	int head = 0;
+	int tail = 0;
+	order[tail++] = source;
+	distances[source] = 0;
+	pathCounts[source] = 1;
+
+	while (head < tail) {
+		int currentCity = order[head++];
+		const StaticBitset<N>& neighbors = adjacency.Row(currentCity);
 
-	for (int i = 0; i < N; i++) {
-		if (next[i] == endNode)
-			temp = true;
+		for (int neighbor = neighbors.FindFirst(); neighbor != -1; neighbor = neighbors.FindNext(neighbor)) {
+			if (distances[neighbor] == -1) {
+				distances[neighbor] = distances[currentCity] + 1;
+				order[tail++] = neighbor;
+			}
+
+			if (distances[neighbor] == distances[currentCity] + 1)
+				pathCounts[neighbor] += pathCounts[currentCity];
+		}
 	}
 
-	if (temp) { // start from end to start if there is a city in between
-		int currentCity = startNode;
-		while (currentCity != endNode) {
-			if (currentCity == node)
-				return 1;
+	for (int i = tail - 1; i > 0; --i) {
+		int city = order[i];
+		const StaticBitset<N>& neighbors = adjacency.Row(city);
 
-			currentCity = next[currentCity];
+		for (int neighbor = neighbors.FindFirst(); neighbor != -1; neighbor = neighbors.FindNext(neighbor)) {
+			if (distances[neighbor] == distances[city] - 1)
+				dependencies[neighbor] += pathCounts[neighbor] / pathCounts[city] * (1.0 + dependencies[city]);
 		}
 
-		return 0; // If node city is not between return 0
+		result[city] += dependencies[city];
 	}
-
-	return 0;
 }
 
 // Find according to visited states of cities
@@ -135,6 +227,14 @@ double FirstOrderNeighbors<T, N>::Score(T node, StaticVector<StaticVector<T, N>,
 	return 1.0 - 1.0 / tempScore;
 }
 
+// Same score using bit rows, counts unvisited neighbors with one popcount per word
+template <class T, unsigned int N>
+double FirstOrderNeighbors<T, N>::Score(T node, const BitAdjacency<N>& graph, const StaticBitset<N>& visited) {
+	double tempScore = graph.UnvisitedDegree(node, visited);
+
+	return 1.0 - 1.0 / tempScore;
+}
+
 // How many neighbors does the node have
 template <class T, unsigned int N>
 int SecondOrderNeighbors<T, N>::FirstOrderNeighborScore(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]) {
@@ -170,6 +270,25 @@ double SecondOrderNeighbors<T, N>::Score(T node, StaticVector<StaticVector<T, N>
 
 }
 
+template <class T, unsigned int N>
+double SecondOrderNeighbors<T, N>::Score(T node, const BitAdjacency<N>& graph, const StaticBitset<N>& visited) {
+
+	if (visited.Test(node))
+		return 0.0;
+
+	StaticBitset<N> candidates = ~visited;
+	candidates &= graph.Row(node); // Unvisited neighbors of the node
+
+	double highestScore = 0;
+	for (int i = candidates.FindFirst(); i != -1; i = candidates.FindNext(i)) {
+		int tempScore = graph.UnvisitedDegree(i, visited);
+		if (tempScore > highestScore)
+			highestScore = tempScore;
+	}
+
+	return 1.0 - 1.0 / highestScore;
+}
+
 template <class T, unsigned int N>
 int ThirdOrderNeighbors<T, N>::FirstOrderNeighborScore(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]) {
 	int tempScore = 0;
@@ -199,6 +318,21 @@ int ThirdOrderNeighbors<T, N>::SecondOrderNeighborScore(T node, StaticVector<Sta
 	return highestScore;
 }
 
+// Visits every neighbor like the matrix version, visited only filters the neighbor's neighbors
+template <class T, unsigned int N>
+int ThirdOrderNeighbors<T, N>::SecondOrderNeighborScore(T node, const BitAdjacency<N>& graph, const StaticBitset<N>& visited) {
+
+	int highestScore = 0;
+	const StaticBitset<N>& neighbors = graph.Row(node);
+	for (int i = neighbors.FindFirst(); i != -1; i = neighbors.FindNext(i)) {
+		int tempScore = graph.UnvisitedDegree(i, visited);
+		if (tempScore > highestScore)
+			highestScore = tempScore;
+	}
+
+	return highestScore;
+}
+
 template <class T, unsigned int N>
 double ThirdOrderNeighbors<T, N>::Score(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]) {
 	if (visited[node])
@@ -219,8 +353,47 @@ double ThirdOrderNeighbors<T, N>::Score(T node, StaticVector<StaticVector<T, N>,
 	return 1.0 - 1.0 / highestScore;
 }
 
+template <class T, unsigned int N>
+double ThirdOrderNeighbors<T, N>::Score(T node, const BitAdjacency<N>& graph, const StaticBitset<N>& visited) {
+	if (visited.Test(node))
+		return 0.0;
+
+	StaticBitset<N> candidates = ~visited;
+	candidates &= graph.Row(node);
+
+	double highestScore = 0;
+	for (int i = candidates.FindFirst(); i != -1; i = candidates.FindNext(i)) {
+		int tempScore = SecondOrderNeighborScore(i, graph, visited);
+		if (tempScore > highestScore)
+			highestScore = tempScore;
+	}
+
+	return 1.0 - 1.0 / highestScore;
+}
+
+template <class T, unsigned int N>
+void ClosenessCentrality<T, N>::Prepare(StaticVector<StaticVector<T, N>, N>& graph) {
+	distanceTable.Build(graph);
+	prepared = true;
+}
+
+template <class T, unsigned int N>
+void ClosenessCentrality<T, N>::Prepare(const BitAdjacency<N>& graph) {
+	distanceTable.Build(graph);
+	prepared = true;
+}
+
+template <class T, unsigned int N>
+void ClosenessCentrality<T, N>::RemoveVertex(T vertex) {
+	if (prepared)
+		distanceTable.RemoveVertex(vertex);
+}
+
 template <class T, unsigned int N>
 double ClosenessCentrality<T, N>::Score(T node, StaticVector<StaticVector<T, N>, N>& adjMatrix, bool visited[N]) {
+	if (prepared)
+		return 1.0 / distanceTable.DistanceSum(node);
+
 	int distances[N];
 
 	ComputeClosenessCentrality(node, adjMatrix, distances);
@@ -235,8 +408,8 @@ double ClosenessCentrality<T, N>::Score(T node, StaticVector<StaticVector<T, N>,
 template <class T, unsigned int N>
 void ClosenessCentrality<T, N>::ComputeClosenessCentrality(T node, StaticVector<StaticVector<T, N>, N>& graph,
 	int distances[N]) {
-	LinkedList<int, N> queue;
-	queue.PushBack(node);
+	StaticRingQueue<int, N> queue;
+	queue.Push(node);
 
 	bool visited[N];
 
@@ -245,15 +418,15 @@ void ClosenessCentrality<T, N>::ComputeClosenessCentrality(T node, StaticVector<
 		distances[i] = 0;
 	}
 
-	while (queue.GetSize() != 0) {
+	while (!queue.IsEmpty()) {
 		int currentCity = queue.Front();
-		queue.Erase(queue.GetIterator());
+		queue.Pop();
 
 		if (!visited[currentCity]) {
 			for (int neighborCity = 0; neighborCity < N; ++neighborCity) {
 				if (graph[currentCity][neighborCity] && !visited[neighborCity]) {
 					distances[neighborCity] = distances[currentCity] + 1;
-					queue.PushBack(neighborCity); // adding neighbor to queue
+					queue.Push(neighborCity); // adding neighbor to queue, a full queue drops it
 				}
 			}
 			visited[currentCity] = true;
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <cstdint>
+#include <StaticVectorLibrary.h>
+#include <StaticBitsetLibrary.h>
+#include <BitAdjacency.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define BAND_FILTER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC compiles intrinsics of any instruction set, GCC and Clang need the target on the function
+#if defined(BAND_FILTER_X86) && !defined(_MSC_VER)
+#define BAND_FILTER_TARGET(instructionSet) __attribute__((target(instructionSet)))
+#else
+#define BAND_FILTER_TARGET(instructionSet)
+#endif
+
+// Distance band filter shared by CreateGraph and the genetic algorithm. A row of distances is filtered to
+// [low, high], values outside the band become 0 like CreateGraph does, and bit j of the row bits is set when
+// the filtered value is not zero. The SIMD kernels compare 4 or 8 distances at once and turn the comparison
+// into row bits with a movemask, the kernel is picked once at runtime from the CPU features.
+enum class BandFilterKernel {
+	Scalar,
+	SSE2,
+	AVX2
+};
+
+// destination can be NULL to only compute the bits, words has (count + 63) / 64 entries
+typedef void (*BandFilterRowFunction)(const int* source, int* destination, int count, int low, int high, uint64_t* words);
+
+// Filters up to 64 values and returns their bits, the loops are simple enough for the compiler to vectorize
+inline uint64_t BandFilterWordScalar(const int* source, int* destination, int length, int low, int high) {
+	int filtered[64];
+
+	for (int j = 0; j < length; ++j) {
+		int value = source[j];
+		filtered[j] = (value > high || value < low) ? 0 : value;
+	}
+
+	if (destination != NULL) {
+		for (int j = 0; j < length; ++j)
+			destination[j] = filtered[j];
+	}
+
+	uint64_t word = 0;
+	for (int j = 0; j < length; ++j) {
+		if (filtered[j] != 0) // Band edges are sparse so this branch is predicted well
+			word |= 1ULL << j;
+	}
+
+	return word;
+}
+
+inline void BandFilterRowScalar(const int* source, int* destination, int count, int low, int high, uint64_t* words) {
+	int wordStart = 0;
+
+	for (; wordStart + 64 <= count; wordStart += 64) // Constant length for full words
+		words[wordStart / 64] = BandFilterWordScalar(source + wordStart, destination == NULL ? NULL : destination + wordStart, 64, low, high);
+
+	if (wordStart < count)
+		words[wordStart / 64] = BandFilterWordScalar(source + wordStart, destination == NULL ? NULL : destination + wordStart, count - wordStart, low, high);
+}
+
+#if defined(BAND_FILTER_X86)
+
+BAND_FILTER_TARGET("sse2")
+inline void BandFilterRowSSE2(const int* source, int* destination, int count, int low, int high, uint64_t* words) {
+	for (int i = 0; i < (count + 63) / 64; ++i)
+		words[i] = 0;
+
+	const __m128i lowValues = _mm_set1_epi32(low);
+	const __m128i highValues = _mm_set1_epi32(high);
+	const __m128i zero = _mm_setzero_si128();
+
+	int j = 0;
+	for (; j + 4 <= count; j += 4) {
+		__m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + j));
+		__m128i outside = _mm_or_si128(_mm_cmpgt_epi32(values, highValues), _mm_cmpgt_epi32(lowValues, values));
+		__m128i filtered = _mm_andnot_si128(outside, values);
+
+		if (destination != NULL)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + j), filtered);
+
+		// One bit per zero lane, inverted to get the edges
+		int bits = ~_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(filtered, zero))) & 0xF;
+		words[j / 64] |= static_cast<uint64_t>(bits) << (j % 64);
+	}
+
+	for (; j < count; ++j) {
+		int value = source[j];
+		if (value > high || value < low)
+			value = 0;
+
+		if (destination != NULL)
+			destination[j] = value;
+		if (value != 0)
+			words[j / 64] |= 1ULL << (j % 64);
+	}
+}
+
+BAND_FILTER_TARGET("avx2")
+inline void BandFilterRowAVX2(const int* source, int* destination, int count, int low, int high, uint64_t* words) {
+	for (int i = 0; i < (count + 63) / 64; ++i)
+		words[i] = 0;
+
+	const __m256i lowValues = _mm256_set1_epi32(low);
+	const __m256i highValues = _mm256_set1_epi32(high);
+	const __m256i zero = _mm256_setzero_si256();
+
+	int j = 0;
+	for (; j + 8 <= count; j += 8) {
+		__m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + j));
+		__m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(values, highValues), _mm256_cmpgt_epi32(lowValues, values));
+		__m256i filtered = _mm256_andnot_si256(outside, values);
+
+		if (destination != NULL)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + j), filtered);
+
+		int bits = ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(filtered, zero))) & 0xFF;
+		words[j / 64] |= static_cast<uint64_t>(bits) << (j % 64); // 8 lanes never cross a word
+	}
+
+	for (; j < count; ++j) {
+		int value = source[j];
+		if (value > high || value < low)
+			value = 0;
+
+		if (destination != NULL)
+			destination[j] = value;
+		if (value != 0)
+			words[j / 64] |= 1ULL << (j % 64);
+	}
+}
+
+#endif
+
+inline bool IsBandFilterKernelSupported(BandFilterKernel kernel) {
+	if (kernel == BandFilterKernel::Scalar)
+		return true;
+
+#if defined(BAND_FILTER_X86) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	bool sse2 = (info[3] & (1 << 26)) != 0;
+	bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+
+	if (kernel == BandFilterKernel::SSE2)
+		return sse2;
+
+	__cpuidex(info, 7, 0);
+	return osSavesAvx && (info[1] & (1 << 5)) != 0;
+#elif defined(BAND_FILTER_X86)
+	if (kernel == BandFilterKernel::SSE2)
+		return __builtin_cpu_supports("sse2");
+
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
+// Fastest kernel the CPU supports
+inline BandFilterKernel DetectBandFilterKernel() {
+	if (IsBandFilterKernelSupported(BandFilterKernel::AVX2))
+		return BandFilterKernel::AVX2;
+	if (IsBandFilterKernelSupported(BandFilterKernel::SSE2))
+		return BandFilterKernel::SSE2;
+
+	return BandFilterKernel::Scalar;
+}
+
+inline BandFilterKernel& ActiveBandFilterKernel() {
+	static BandFilterKernel kernel = DetectBandFilterKernel();
+	return kernel;
+}
+
+inline BandFilterKernel GetBandFilterKernel() {
+	return ActiveBandFilterKernel();
+}
+
+// Forces a kernel, for benchmarks and comparing the kernels. Returns false if the CPU doesn't support it.
+inline bool SetBandFilterKernel(BandFilterKernel kernel) {
+	if (!IsBandFilterKernelSupported(kernel))
+		return false;
+
+	ActiveBandFilterKernel() = kernel;
+	return true;
+}
+
+inline const char* GetBandFilterKernelName(BandFilterKernel kernel) {
+	switch (kernel) {
+	case BandFilterKernel::SSE2:
+		return "SSE2";
+	case BandFilterKernel::AVX2:
+		return "AVX2";
+	default:
+		return "Scalar";
+	}
+}
+
+inline BandFilterRowFunction GetBandFilterRowFunction(BandFilterKernel kernel) {
+#if defined(BAND_FILTER_X86)
+	if (kernel == BandFilterKernel::AVX2)
+		return BandFilterRowAVX2;
+	if (kernel == BandFilterKernel::SSE2)
+		return BandFilterRowSSE2;
+#endif
+	return BandFilterRowScalar;
+}
+
+inline void BandFilterRow(const int* source, int* destination, int count, int low, int high, uint64_t* words) {
+	GetBandFilterRowFunction(ActiveBandFilterKernel())(source, destination, count, low, high, words);
+}
+
+// Filters every row of source into destination and builds the bit rows of the filtered graph in the same pass.
+// source and destination can be the same matrix, adjacency can be NULL.
+template <unsigned int N>
+void FilterBand(StaticVector<StaticVector<int, N>, N>& source, StaticVector<StaticVector<int, N>, N>& destination,
+	BitAdjacency<N>* adjacency, int low, int high) {
+
+	BandFilterRowFunction filterRow = GetBandFilterRowFunction(ActiveBandFilterKernel());
+	uint64_t words[StaticBitset<N>::WORD_COUNT];
+	StaticBitset<N> row;
+
+	for (int i = 0; i < N; ++i) {
+		filterRow(&source[i][0], &destination[i][0], N, low, high, words);
+
+		if (adjacency != NULL) {
+			for (int w = 0; w < StaticBitset<N>::WORD_COUNT; ++w)
+				row.SetWord(w, words[w]);
+			adjacency->SetRow(i, row);
+		}
+	}
+}
+
+// Bit rows of the pairs in [low, high] without changing the matrix
+template <unsigned int N>
+void BuildBandAdjacency(StaticVector<StaticVector<int, N>, N>& distances, BitAdjacency<N>& adjacency, int low, int high) {
+	BandFilterRowFunction filterRow = GetBandFilterRowFunction(ActiveBandFilterKernel());
+	uint64_t words[StaticBitset<N>::WORD_COUNT];
+	StaticBitset<N> row;
+
+	for (int i = 0; i < N; ++i) {
+		filterRow(&distances[i][0], NULL, N, low, high, words);
+
+		for (int w = 0; w < StaticBitset<N>::WORD_COUNT; ++w)
+			row.SetWord(w, words[w]);
+		adjacency.SetRow(i, row);
+	}
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <StaticBitsetLibrary.h>
+#include <StaticVectorLibrary.h>
+
+// Adjacency of the filtered city graph stored as one bit row per city.
+// For 81 cities the whole graph is 81 * 2 words, neighbor tests are bit tests and
+// neighbor counts are popcounts.
+template <unsigned int N>
+class BitAdjacency {
+public:
+	BitAdjacency() = default;
+
+	// Builds the rows from a filtered distance matrix, non zero entries are edges
+	template <class T>
+	void Build(StaticVector<StaticVector<T, N>, N>& graph);
+
+	void Clear();
+
+	void AddEdge(int from, int to);
+	void RemoveEdge(int from, int to);
+
+	// Single direction versions, for matrices which are not symmetric
+	void AddArc(int from, int to);
+	void RemoveArc(int from, int to);
+
+	// Replaces the neighbors of the vertex, single direction like AddArc
+	void SetRow(int vertex, const StaticBitset<N>& row);
+
+	bool HasEdge(int from, int to) const;
+
+	// Removes every edge of the vertex, same as zeroing its row and column in the matrix
+	void RemoveVertex(int vertex);
+
+	const StaticBitset<N>& Row(int vertex) const;
+
+	int Degree(int vertex) const;
+
+	// Number of neighbors which are not in visited, popcount(row & ~visited)
+	int UnvisitedDegree(int vertex, const StaticBitset<N>& visited) const;
+
+private:
+	StaticBitset<N> rows[N];
+};
+
+template <unsigned int N>
+template <class T>
+void BitAdjacency<N>::Build(StaticVector<StaticVector<T, N>, N>& graph) {
+	for (int i = 0; i < N; ++i) {
+		rows[i].Clear();
+		for (int j = 0; j < N; ++j) {
+			if (graph[i][j])
+				rows[i].Set(j);
+		}
+	}
+}
+
+template <unsigned int N>
+void BitAdjacency<N>::Clear() {
+	for (int i = 0; i < N; ++i)
+		rows[i].Clear();
+}
+
+template <unsigned int N>
+void BitAdjacency<N>::AddEdge(int from, int to) {
+	rows[from].Set(to);
+	rows[to].Set(from);
+}
+
+template <unsigned int N>
+void BitAdjacency<N>::RemoveEdge(int from, int to) {
+	rows[from].Reset(to);
+	rows[to].Reset(from);
+}
+
+template <unsigned int N>
+void BitAdjacency<N>::AddArc(int from, int to) {
+	rows[from].Set(to);
+}
+
+template <unsigned int N>
+void BitAdjacency<N>::RemoveArc(int from, int to) {
+	rows[from].Reset(to);
+}
+
+template <unsigned int N>
+void BitAdjacency<N>::SetRow(int vertex, const StaticBitset<N>& row) {
+	rows[vertex] = row;
+}
+
+template <unsigned int N>
+bool BitAdjacency<N>::HasEdge(int from, int to) const {
+	return rows[from].Test(to);
+}
+
+template <unsigned int N>
+void BitAdjacency<N>::RemoveVertex(int vertex) {
+	for (int neighbor = rows[vertex].FindFirst(); neighbor != -1; neighbor = rows[vertex].FindNext(neighbor))
+		rows[neighbor].Reset(vertex);
+
+	rows[vertex].Clear();
+}
+
+template <unsigned int N>
+const StaticBitset<N>& BitAdjacency<N>::Row(int vertex) const {
+	return rows[vertex];
+}
+
+template <unsigned int N>
+int BitAdjacency<N>::Degree(int vertex) const {
+	return rows[vertex].Count();
+}
+
+template <unsigned int N>
+int BitAdjacency<N>::UnvisitedDegree(int vertex, const StaticBitset<N>& visited) const {
+	return rows[vertex].CountAndNot(visited);
+}
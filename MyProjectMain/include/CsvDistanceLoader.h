@@ -0,0 +1,260 @@
+#pragma once
+
+#include <climits>
+#include <cstring>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <MappedFile.h>
+#include <WorkStealingThreadPool.h>
+#include <RuntimeGraph.h>
+
+// Problem found in a row of the table, lines are counted from 1 like text editors
+struct CsvRowError {
+	int line;
+	std::string message;
+};
+
+struct CsvLoadResult {
+	bool success = false;
+	int cityCount = 0;
+	int headerLineCount = 0;
+	double milliseconds = 0;
+	std::vector<CsvRowError> errors;
+};
+
+// Loads a distance table like ilmesafe.csv: header lines, then "plate;name;distance;distance;..." for every city.
+// The file is memory mapped and the numbers are parsed in place, no line or token is copied into a string.
+// Header lines are the lines before the first row starting with a plate number, they are skipped without decoding
+// so the Windows-1254 Turkish title of ilmesafe.csv and UTF-8 headers are both fine. City names are kept as bytes.
+// Rows are split between the pool's threads when the table is large.
+class CsvDistanceLoader {
+public:
+	// Tables with fewer cities are parsed on the calling thread
+	static const int PARALLEL_CITY_COUNT = 512;
+	static const int ROWS_PER_TASK = 32;
+
+	// Errors stop being collected after this many, the load still fails
+	static const int MAX_REPORTED_ERRORS = 100;
+
+	// pool can be NULL to parse on the calling thread
+	explicit CsvDistanceLoader(WorkStealingThreadPool* pool = NULL) : threadPool(pool) {
+	}
+
+	CsvLoadResult Load(const std::string& fileName, std::unique_ptr<RuntimeGraph>& graph);
+	CsvLoadResult Load(const char* data, size_t size, std::unique_ptr<RuntimeGraph>& graph);
+
+private:
+	struct Line {
+		const char* begin;
+		const char* end; // Without the line break
+		int number;
+	};
+
+	static void SplitLines(const char* data, size_t size, std::vector<Line>& lines);
+	static bool IsCityRow(const Line& line);
+	static bool IsEmptyRow(const Line& line);
+	static void ParseRow(const Line& line, int city, RuntimeGraph& graph, std::vector<CsvRowError>& errors);
+
+	WorkStealingThreadPool* threadPool;
+};
+
+inline CsvLoadResult CsvDistanceLoader::Load(const std::string& fileName, std::unique_ptr<RuntimeGraph>& graph) {
+	MappedFile file;
+
+	if (!file.Open(fileName)) {
+		CsvLoadResult result;
+		result.errors.push_back(CsvRowError{ 0, "can't open " + fileName });
+		return result;
+	}
+
+	return Load(file.GetData(), file.GetSize(), graph);
+}
+
+inline CsvLoadResult CsvDistanceLoader::Load(const char* data, size_t size, std::unique_ptr<RuntimeGraph>& graph) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	CsvLoadResult result;
+
+	if (size >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0) { // UTF-8 byte order mark
+		data += 3;
+		size -= 3;
+	}
+
+	std::vector<Line> lines;
+	SplitLines(data, size, lines);
+
+	// Header lines until the first city row, after that every non empty line has to be a city row
+	size_t first = 0;
+	while (first < lines.size() && !IsCityRow(lines[first]))
+		first++;
+	result.headerLineCount = static_cast<int>(first);
+
+	std::vector<Line> rows;
+	for (size_t i = first; i < lines.size(); ++i) {
+		if (IsCityRow(lines[i]))
+			rows.push_back(lines[i]);
+		else if (!IsEmptyRow(lines[i]) && result.errors.size() < MAX_REPORTED_ERRORS)
+			result.errors.push_back(CsvRowError{ lines[i].number, "not a city row" });
+	}
+
+	result.cityCount = static_cast<int>(rows.size());
+	if (rows.empty()) {
+		result.errors.push_back(CsvRowError{ 0, "no city rows" });
+		return result;
+	}
+
+	graph.reset(new RuntimeGraph(result.cityCount));
+	RuntimeGraph& table = *graph;
+
+	int taskCount = (result.cityCount + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+	std::vector<std::vector<CsvRowError>> taskErrors(taskCount);
+
+	auto parseTask = [&](int task, int) {
+		int end = std::min(result.cityCount, (task + 1) * ROWS_PER_TASK);
+		for (int city = task * ROWS_PER_TASK; city < end; ++city)
+			ParseRow(rows[city], city, table, taskErrors[task]);
+	};
+
+	if (threadPool != NULL && result.cityCount >= PARALLEL_CITY_COUNT)
+		threadPool->ParallelFor(taskCount, parseTask);
+	else {
+		for (int task = 0; task < taskCount; ++task)
+			parseTask(task, 0);
+	}
+
+	// Tasks hold consecutive rows so the errors stay in line order
+	for (int task = 0; task < taskCount; ++task) {
+		for (size_t i = 0; i < taskErrors[task].size() && result.errors.size() < MAX_REPORTED_ERRORS; ++i)
+			result.errors.push_back(taskErrors[task][i]);
+	}
+
+	std::sort(result.errors.begin(), result.errors.end(), [](const CsvRowError& lhs, const CsvRowError& rhs) {
+		return lhs.line < rhs.line;
+	});
+
+	result.success = result.errors.empty();
+	result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+inline void CsvDistanceLoader::SplitLines(const char* data, size_t size, std::vector<Line>& lines) {
+	const char* position = data;
+	const char* end = data + size;
+	int number = 1;
+
+	while (position < end) {
+		const char* lineEnd = static_cast<const char*>(memchr(position, '\n', end - position));
+		if (lineEnd == NULL)
+			lineEnd = end;
+
+		const char* contentEnd = lineEnd;
+		if (contentEnd > position && contentEnd[-1] == '\r')
+			contentEnd--;
+
+		lines.push_back(Line{ position, contentEnd, number++ });
+		position = lineEnd + 1;
+	}
+}
+
+// A city row starts with a plate number followed by a non empty name
+inline bool CsvDistanceLoader::IsCityRow(const Line& line) {
+	const char* position = line.begin;
+
+	while (position < line.end && *position == ' ')
+		position++;
+
+	const char* digits = position;
+	while (position < line.end && *position >= '0' && *position <= '9')
+		position++;
+
+	if (position == digits)
+		return false;
+
+	while (position < line.end && *position == ' ')
+		position++;
+
+	return position + 1 < line.end && *position == ';' && position[1] != ';';
+}
+
+// Lines with only separators and spaces, ilmesafe.csv ends with a few of them
+inline bool CsvDistanceLoader::IsEmptyRow(const Line& line) {
+	for (const char* position = line.begin; position < line.end; ++position) {
+		if (*position != ';' && *position != ' ' && *position != '\t')
+			return false;
+	}
+
+	return true;
+}
+
+inline void CsvDistanceLoader::ParseRow(const Line& line, int city, RuntimeGraph& graph, std::vector<CsvRowError>& errors) {
+	const char* position = static_cast<const char*>(memchr(line.begin, ';', line.end - line.begin)) + 1; // After the plate
+	const char* nameEnd = static_cast<const char*>(memchr(position, ';', line.end - position));
+
+	if (nameEnd == NULL) {
+		errors.push_back(CsvRowError{ line.number, "no distances" });
+		return;
+	}
+
+	graph.GetNames()[city].assign(position, nameEnd);
+	position = nameEnd + 1;
+
+	int cityCount = graph.GetCityCount();
+	int* row = graph.DistanceRow(city);
+	int column = 0;
+
+	for (; column < cityCount && position <= line.end; ++column) {
+		while (position < line.end && *position == ' ')
+			position++;
+
+		bool negative = position < line.end && *position == '-';
+		if (negative)
+			position++;
+
+		const char* digits = position;
+		int value = 0;
+		bool overflow = false;
+		while (position < line.end && *position >= '0' && *position <= '9') {
+			int digit = *position++ - '0';
+			if (value > (INT_MAX - digit) / 10) // Long digit runs would overflow, the rest of them is only skipped
+				overflow = true;
+			else if (!overflow)
+				value = value * 10 + digit;
+		}
+		bool hasDigits = position != digits; // Checked before the trailing spaces, "- ;" has none
+
+		while (position < line.end && *position == ' ')
+			position++;
+
+		if (!hasDigits || (position < line.end && *position != ';')) {
+			errors.push_back(CsvRowError{ line.number, "distance " + std::to_string(column + 1) + " of " +
+				graph.GetNames()[city] + " is not a number" });
+			return;
+		}
+
+		if (overflow) {
+			errors.push_back(CsvRowError{ line.number, "distance " + std::to_string(column + 1) + " of " +
+				graph.GetNames()[city] + " is too large" });
+			return;
+		}
+
+		row[column] = negative ? -value : value;
+		position++; // Separator
+	}
+
+	if (column < cityCount) {
+		errors.push_back(CsvRowError{ line.number, graph.GetNames()[city] + " has " + std::to_string(column) +
+			" distances, expected " + std::to_string(cityCount) });
+		return;
+	}
+
+	// Only empty fields can follow the last distance
+	for (; position < line.end; ++position) {
+		if (*position != ';' && *position != ' ') {
+			errors.push_back(CsvRowError{ line.number, graph.GetNames()[city] + " has more than " +
+				std::to_string(cityCount) + " distances" });
+			return;
+		}
+	}
+}
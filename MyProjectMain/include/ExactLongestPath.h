@@ -0,0 +1,270 @@
+#pragma once
+
+#include <chrono>
+#include <StaticBitsetLibrary.h>
+#include <StaticVectorLibrary.h>
+#include <BitAdjacency.h>
+
+// Result of the exact solver. Lengths are city counts like the heuristics return.
+// If the time budget is hit the best path found is a lower bound and upperBound is
+// the highest length any unexplored branch could still reach.
+template <unsigned int N>
+struct ExactLongestPathResult {
+	StaticVector<int, N> path;
+	int lowerBound = 0;
+	int upperBound = 0;
+	bool certified = false; // true if the search finished and lowerBound is the optimum
+	long long expandedStates = 0;
+	double elapsedMilliseconds = 0;
+};
+
+// Branch and bound search for the longest simple path starting from a city.
+//
+// Bound: a path can only grow into the unvisited cities reachable from its end, and
+// of the reachable cities with a single reachable neighbor at most one can be visited
+// (the path has to end there).
+// Dominance: the rest of the search depends only on the current city and the reachable
+// set, so a state already reached with a longer or equal prefix is pruned.
+// Ordering: neighbors with fewer unvisited neighbors are tried first (Warnsdorff) since
+// they are the ones a long path has to collect before they become unreachable.
+template <unsigned int N>
+class ExactLongestPathSolver {
+public:
+	// Memo table has 2^memoBits entries
+	ExactLongestPathSolver(int memoBits = 18);
+	~ExactLongestPathSolver();
+
+	ExactLongestPathSolver(const ExactLongestPathSolver&) = delete;
+	ExactLongestPathSolver& operator=(const ExactLongestPathSolver&) = delete;
+
+	// timeBudgetMilliseconds <= 0 means no time limit
+	ExactLongestPathResult<N> Solve(const BitAdjacency<N>& graph, int startCity, double timeBudgetMilliseconds);
+
+private:
+	struct MemoEntry {
+		StaticBitset<N> reachable;
+		int city = -1; // -1 is an empty entry
+		int depth = 0;
+	};
+
+	void Search(int currentCity, int depth);
+
+	// Unvisited cities reachable from the city through unvisited cities
+	void ComputeReachable(int city, StaticBitset<N>& reachable) const;
+	int UpperBound(int city, int depth, const StaticBitset<N>& reachable) const;
+
+	// Returns true if an entry with the same state and a longer or equal prefix exists, otherwise stores the state
+	bool IsDominated(int city, int depth, const StaticBitset<N>& reachable);
+
+	bool IsTimeUp();
+
+	const BitAdjacency<N>* graph;
+	StaticBitset<N> visited;
+	int currentPath[N];
+	int bestPath[N];
+	int bestLength;
+	int openBound; // Highest bound of the branches left unexplored because of the time budget
+	bool timedOut;
+	long long expandedStates;
+
+	MemoEntry* memo;
+	unsigned int memoMask;
+
+	std::chrono::steady_clock::time_point startTime;
+	double timeBudget;
+};
+
+template <unsigned int N>
+ExactLongestPathSolver<N>::ExactLongestPathSolver(int memoBits) : graph(NULL), bestLength(0), openBound(0),
+	timedOut(false), expandedStates(0), timeBudget(0) {
+	memoMask = (1u << memoBits) - 1;
+	memo = new MemoEntry[memoMask + 1];
+}
+
+template <unsigned int N>
+ExactLongestPathSolver<N>::~ExactLongestPathSolver() {
+	delete[] memo;
+}
+
+template <unsigned int N>
+ExactLongestPathResult<N> ExactLongestPathSolver<N>::Solve(const BitAdjacency<N>& adjacency, int startCity, double timeBudgetMilliseconds) {
+	graph = &adjacency;
+	visited.Clear();
+	bestLength = 0;
+	openBound = 0;
+	timedOut = false;
+	expandedStates = 0;
+	timeBudget = timeBudgetMilliseconds;
+	startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i <= memoMask; ++i)
+		memo[i].city = -1;
+
+	visited.Set(startCity);
+	currentPath[0] = startCity;
+	Search(startCity, 1);
+
+	ExactLongestPathResult<N> result;
+	for (int i = 0; i < bestLength; ++i)
+		result.path.PushBack(bestPath[i]);
+
+	result.lowerBound = bestLength;
+	result.upperBound = (timedOut && openBound > bestLength) ? openBound : bestLength;
+	result.certified = !timedOut;
+	result.expandedStates = expandedStates;
+	result.elapsedMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+	return result;
+}
+
+template <unsigned int N>
+void ExactLongestPathSolver<N>::Search(int currentCity, int depth) {
+	expandedStates++;
+
+	if (depth > bestLength) { // Every prefix is a valid path so the best is updated before bounding
+		bestLength = depth;
+		for (int i = 0; i < depth; ++i)
+			bestPath[i] = currentPath[i];
+	}
+
+	StaticBitset<N> reachable;
+	ComputeReachable(currentCity, reachable);
+
+	int bound = UpperBound(currentCity, depth, reachable);
+
+	if (IsTimeUp()) {
+		if (bound > openBound)
+			openBound = bound;
+		return;
+	}
+
+	if (bound <= bestLength)
+		return;
+
+	if (IsDominated(currentCity, depth, reachable))
+		return;
+
+	// Ordering the unvisited neighbors by their unvisited degree
+	int candidates[N];
+	int candidateDegrees[N];
+	int candidateCount = 0;
+
+	StaticBitset<N> neighbors = graph->Row(currentCity);
+	neighbors.AndNot(visited);
+
+	for (int neighbor = neighbors.FindFirst(); neighbor != -1; neighbor = neighbors.FindNext(neighbor)) {
+		int degree = graph->UnvisitedDegree(neighbor, visited);
+		int j = candidateCount - 1;
+		while (j >= 0 && candidateDegrees[j] > degree) {
+			candidates[j + 1] = candidates[j];
+			candidateDegrees[j + 1] = candidateDegrees[j];
+			j--;
+		}
+		candidates[j + 1] = neighbor;
+		candidateDegrees[j + 1] = degree;
+		candidateCount++;
+	}
+
+	for (int i = 0; i < candidateCount; ++i) {
+		int neighbor = candidates[i];
+
+		visited.Set(neighbor);
+		currentPath[depth] = neighbor;
+		Search(neighbor, depth + 1);
+		visited.Reset(neighbor);
+
+		if (timedOut) {
+			if (i + 1 < candidateCount && bound > openBound) // Remaining neighbors are bounded by this state
+				openBound = bound;
+			return;
+		}
+
+		if (bestLength >= bound) // Bound reached, no neighbor can do better
+			return;
+	}
+}
+
+template <unsigned int N>
+void ExactLongestPathSolver<N>::ComputeReachable(int city, StaticBitset<N>& reachable) const {
+	StaticBitset<N> frontier = graph->Row(city);
+	frontier.AndNot(visited);
+	reachable = frontier;
+
+	while (frontier.Any()) {
+		StaticBitset<N> next;
+		for (int i = frontier.FindFirst(); i != -1; i = frontier.FindNext(i))
+			next |= graph->Row(i);
+
+		next.AndNot(visited);
+		next.AndNot(reachable);
+		reachable |= next;
+		frontier = next;
+	}
+}
+
+template <unsigned int N>
+int ExactLongestPathSolver<N>::UpperBound(int city, int depth, const StaticBitset<N>& reachable) const {
+	StaticBitset<N> area = reachable;
+	area.Set(city);
+
+	int leafCount = 0;
+	for (int i = reachable.FindFirst(); i != -1; i = reachable.FindNext(i)) {
+		StaticBitset<N> neighbors = graph->Row(i);
+		neighbors &= area;
+		if (neighbors.Count() <= 1)
+			leafCount++;
+	}
+
+	int bound = depth + reachable.Count();
+	if (leafCount > 1)
+		bound -= leafCount - 1;
+
+	return bound;
+}
+
+template <unsigned int N>
+bool ExactLongestPathSolver<N>::IsDominated(int city, int depth, const StaticBitset<N>& reachable) {
+	uint64_t hash = static_cast<uint64_t>(city) * 0x9E3779B97F4A7C15ULL;
+	for (int i = 0; i < StaticBitset<N>::WORD_COUNT; ++i) {
+		hash ^= reachable.GetWord(i) + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+	}
+	hash ^= hash >> 31;
+
+	unsigned int index = static_cast<unsigned int>(hash) & memoMask;
+
+	// Short linear probe, the table is a cache so the last probed entry is replaced when all are taken
+	for (int probe = 0; probe < 4; ++probe) {
+		MemoEntry& entry = memo[(index + probe) & memoMask];
+
+		if (entry.city == -1 || probe == 3) {
+			entry.city = city;
+			entry.reachable = reachable;
+			entry.depth = depth;
+			return false;
+		}
+
+		if (entry.city == city && entry.reachable == reachable) {
+			if (entry.depth >= depth)
+				return true;
+
+			entry.depth = depth;
+			return false;
+		}
+	}
+
+	return false;
+}
+
+template <unsigned int N>
+bool ExactLongestPathSolver<N>::IsTimeUp() {
+	if (timedOut)
+		return true;
+
+	if (timeBudget <= 0 || (expandedStates & 255) != 0) // Reading the clock only every 256 states
+		return false;
+
+	double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	timedOut = elapsed > timeBudget;
+
+	return timedOut;
+}
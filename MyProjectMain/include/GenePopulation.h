@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstring>
+#include <new>
+#include <StaticBitsetLibrary.h>
+#include <RuntimeGraph.h>
+
+// Population of a genetic algorithm stored as arrays in one arena: a gene matrix with N genes per individual,
+// the gene counts, the fitness scores and the bitset of the cities in every gnome. There are two buffers,
+// operators write the next generation into the other buffer and Swap makes it the current one, so individuals
+// are never allocated or copied between generations.
+template <class T, unsigned int N>
+class GenePopulation {
+public:
+	explicit GenePopulation(int populationCapacity)
+		: arena(GetArenaBytes(populationCapacity)), capacity(populationCapacity), size(0), current(0) {
+
+		for (int buffer = 0; buffer < 2; ++buffer) {
+			genes[buffer] = arena.Allocate<T>(static_cast<size_t>(capacity) * N);
+			lengths[buffer] = arena.Allocate<int>(capacity);
+			fitness[buffer] = arena.Allocate<int>(capacity);
+			members[buffer] = arena.Allocate<StaticBitset<N>>(capacity);
+
+			for (int i = 0; i < capacity; ++i)
+				new (members[buffer] + i) StaticBitset<N>();
+		}
+	}
+
+	int GetCapacity() const { return capacity; }
+	int GetSize() const { return size; }
+
+	// Individuals of the current generation
+	T* Genes(int individual) { return genes[current] + static_cast<size_t>(individual) * N; }
+	const T* Genes(int individual) const { return genes[current] + static_cast<size_t>(individual) * N; }
+	int& Length(int individual) { return lengths[current][individual]; }
+	int Length(int individual) const { return lengths[current][individual]; }
+	int& Fitness(int individual) { return fitness[current][individual]; }
+	int Fitness(int individual) const { return fitness[current][individual]; }
+	StaticBitset<N>& Members(int individual) { return members[current][individual]; }
+	const StaticBitset<N>& Members(int individual) const { return members[current][individual]; }
+
+	// Individuals of the generation being created
+	T* NextGenes(int individual) { return genes[1 - current] + static_cast<size_t>(individual) * N; }
+	int& NextLength(int individual) { return lengths[1 - current][individual]; }
+	int& NextFitness(int individual) { return fitness[1 - current][individual]; }
+	StaticBitset<N>& NextMembers(int individual) { return members[1 - current][individual]; }
+
+	// Count of individuals written to the current buffer, used while the first generation is created
+	void SetSize(int count) { size = count; }
+
+	// Makes the next generation the current one, nextSize individuals were written to it
+	void Swap(int nextSize) {
+		current = 1 - current;
+		size = nextSize;
+	}
+
+	// Writes an individual to the current or the next generation, for elites and migrants
+	void Store(int individual, const T* source, int length, int score) {
+		std::memcpy(Genes(individual), source, length * sizeof(T));
+		Length(individual) = length;
+		Fitness(individual) = score;
+		SetMembers(Members(individual), source, length);
+	}
+
+	void StoreNext(int individual, const T* source, int length, int score) {
+		std::memcpy(NextGenes(individual), source, length * sizeof(T));
+		NextLength(individual) = length;
+		NextFitness(individual) = score;
+		SetMembers(NextMembers(individual), source, length);
+	}
+
+	// Copies an individual of the current generation to the next one, for elites
+	void CopyToNext(int individual, int nextIndividual) {
+		std::memcpy(NextGenes(nextIndividual), Genes(individual), Length(individual) * sizeof(T));
+		NextLength(nextIndividual) = Length(individual);
+		NextFitness(nextIndividual) = Fitness(individual);
+		NextMembers(nextIndividual) = Members(individual);
+	}
+
+private:
+	static void SetMembers(StaticBitset<N>& bitset, const T* source, int length) {
+		bitset.Clear();
+		for (int i = 0; i < length; ++i)
+			bitset.Set(source[i]);
+	}
+
+	static size_t GetArenaBytes(int populationCapacity) {
+		size_t buffer = static_cast<size_t>(populationCapacity) * (N * sizeof(T) + 2 * sizeof(int) + sizeof(StaticBitset<N>))
+			+ 2 * alignof(T) + 2 * alignof(int) + alignof(StaticBitset<N>);
+		return 2 * buffer;
+	}
+
+	GraphArena arena;
+	int capacity;
+	int size;
+	int current;
+	T* genes[2];
+	int* lengths[2];
+	int* fitness[2];
+	StaticBitset<N>* members[2];
+};
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <MappedFile.h>
+#include <RuntimeGraph.h>
+#include <BandFilter.h>
+
+// Binary copy of a distance table, written once from the CSV and memory mapped on later runs.
+//
+// Layout, every section starts at a multiple of 8 bytes and numbers are in the byte order of the machine:
+//   GraphCacheHeader
+//   names: (cityCount + 1) uint32 offsets into the name bytes, then the name bytes
+//   distances: cityCount * cityCount uint16, row by row
+//   bands: bandCount times { int32 low, int32 high, cityCount * wordCount uint64 bit rows }
+//
+// The checksum covers everything after the header. sourceHash is the HashBytes of the CSV the cache was made
+// from, a cache of another CSV or a cache written on a machine with the other byte order is not used.
+// sourceSize and sourceModified are the FileStamp of that CSV, while they match the CSV isn't read at all.
+// A graph loaded from the cache reads the distances from the mapping, a cached start only pages in what it touches.
+struct GraphCacheHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t cityCount;
+	uint32_t bandCount;
+	uint32_t reserved;
+	uint64_t sourceHash;
+	uint64_t sourceSize;
+	int64_t sourceModified;
+	uint64_t namesOffset;
+	uint64_t distancesOffset;
+	uint64_t bandsOffset;
+	uint64_t fileSize;
+	uint64_t checksum;
+};
+
+struct GraphCacheBand {
+	int low;
+	int high;
+};
+
+// FNV-1a on 8 byte words, fast enough to check a source file or a cache while it is paged in
+inline uint64_t HashBytes(const char* data, size_t size) {
+	uint64_t hash = 14695981039346656037ULL;
+	size_t i = 0;
+
+	for (; i + 8 <= size; i += 8) {
+		uint64_t word;
+		memcpy(&word, data + i, 8);
+		hash = (hash ^ word) * 1099511628211ULL;
+	}
+
+	for (; i < size; ++i)
+		hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+
+	return hash;
+}
+
+class GraphCache {
+public:
+	static const uint32_t VERSION = 2;
+
+	// Distances are stored in 16 bits, tables with negative or larger distances can't be cached
+	static const int MAX_DISTANCE = 65535;
+
+	// Writes the distances and names of graph with the bit rows of every band. Returns false if the table
+	// doesn't fit the format or the file can't be written. The file is written under another name and renamed,
+	// so graphs still mapping the previous cache keep their pages.
+	static bool Write(const std::string& fileName, const RuntimeGraph& graph, uint64_t sourceHash, const FileStamp& sourceStamp,
+		const std::vector<GraphCacheBand>& bands);
+
+	// Replaces the source stamp in the header of a cache, for a CSV which got another write time but has the same hash
+	static bool WriteSourceStamp(const std::string& fileName, const FileStamp& sourceStamp);
+
+	// Maps the cache and checks the header, the size and the checksum
+	bool Open(const std::string& fileName);
+	void Close();
+
+	bool IsOpen() const { return header != NULL; }
+	int GetCityCount() const { return static_cast<int>(header->cityCount); }
+	uint64_t GetSourceHash() const { return header->sourceHash; }
+
+	// True if the CSV still has the size and the write time it had when the cache was written
+	bool HasSourceStamp(const FileStamp& stamp) const {
+		return header->sourceSize == stamp.size && header->sourceModified == stamp.modified;
+	}
+
+	// Creates the graph with the cached names, the distances stay in the mapping which the graph keeps open
+	bool Load(std::unique_ptr<RuntimeGraph>& graph);
+
+	bool HasBand(int low, int high) const { return FindBand(low, high) != NULL; }
+
+	// Same result as graph.FilterBand(low, high) from the cached bit rows, false if the band isn't cached
+	bool LoadBand(RuntimeGraph& graph, int low, int high) const;
+
+	GraphCache() : header(NULL) {
+	}
+
+private:
+	static size_t Align(size_t offset) { return (offset + 7) / 8 * 8; }
+
+	const uint64_t* FindBand(int low, int high) const;
+
+	std::shared_ptr<MappedFile> file; // Shared with the graphs loaded from it
+	const GraphCacheHeader* header;
+};
+
+inline bool GraphCache::Write(const std::string& fileName, const RuntimeGraph& graph, uint64_t sourceHash, const FileStamp& sourceStamp,
+	const std::vector<GraphCacheBand>& bands) {
+	size_t cityCount = graph.GetCityCount();
+	size_t wordCount = graph.GetWordCount();
+	std::vector<int> rowBuffer(cityCount);
+
+	for (size_t i = 0; i < cityCount; ++i) {
+		const int* row = graph.ReadDistanceRow(static_cast<int>(i), rowBuffer.data());
+		for (size_t j = 0; j < cityCount; ++j) {
+			if (row[j] < 0 || row[j] > MAX_DISTANCE)
+				return false;
+		}
+	}
+
+	size_t nameBytes = 0;
+	for (size_t i = 0; i < cityCount; ++i)
+		nameBytes += graph.GetNames()[i].size();
+
+	GraphCacheHeader fileHeader;
+	memset(&fileHeader, 0, sizeof(fileHeader));
+	memcpy(fileHeader.magic, "CITYGRPH", 8);
+	fileHeader.version = VERSION;
+	fileHeader.cityCount = static_cast<uint32_t>(cityCount);
+	fileHeader.bandCount = static_cast<uint32_t>(bands.size());
+	fileHeader.sourceHash = sourceHash;
+	fileHeader.sourceSize = sourceStamp.size;
+	fileHeader.sourceModified = sourceStamp.modified;
+	fileHeader.namesOffset = sizeof(GraphCacheHeader);
+	fileHeader.distancesOffset = Align(fileHeader.namesOffset + (cityCount + 1) * sizeof(uint32_t) + nameBytes);
+	fileHeader.bandsOffset = Align(fileHeader.distancesOffset + cityCount * cityCount * sizeof(uint16_t));
+	fileHeader.fileSize = fileHeader.bandsOffset + bands.size() * (2 * sizeof(int32_t) + cityCount * wordCount * sizeof(uint64_t));
+
+	std::vector<char> buffer(static_cast<size_t>(fileHeader.fileSize), 0);
+
+	uint32_t* nameOffsets = reinterpret_cast<uint32_t*>(&buffer[fileHeader.namesOffset]);
+	char* names = reinterpret_cast<char*>(nameOffsets + cityCount + 1);
+	uint32_t nameOffset = 0;
+	for (size_t i = 0; i < cityCount; ++i) {
+		const std::string& name = graph.GetNames()[i];
+		nameOffsets[i] = nameOffset;
+		memcpy(names + nameOffset, name.data(), name.size());
+		nameOffset += static_cast<uint32_t>(name.size());
+	}
+	nameOffsets[cityCount] = nameOffset;
+
+	uint16_t* distances = reinterpret_cast<uint16_t*>(&buffer[fileHeader.distancesOffset]);
+	for (size_t i = 0; i < cityCount; ++i) {
+		const int* row = graph.ReadDistanceRow(static_cast<int>(i), rowBuffer.data());
+		for (size_t j = 0; j < cityCount; ++j)
+			distances[i * cityCount + j] = static_cast<uint16_t>(row[j]);
+	}
+
+	char* band = &buffer[fileHeader.bandsOffset];
+	for (size_t b = 0; b < bands.size(); ++b) {
+		int32_t limits[2] = { bands[b].low, bands[b].high };
+		memcpy(band, limits, sizeof(limits));
+
+		uint64_t* words = reinterpret_cast<uint64_t*>(band + sizeof(limits));
+		for (size_t i = 0; i < cityCount; ++i)
+			BandFilterRow(graph.ReadDistanceRow(static_cast<int>(i), rowBuffer.data()), NULL, static_cast<int>(cityCount), bands[b].low, bands[b].high, words + i * wordCount);
+
+		band += sizeof(limits) + cityCount * wordCount * sizeof(uint64_t);
+	}
+
+	fileHeader.checksum = HashBytes(buffer.data() + sizeof(GraphCacheHeader), buffer.size() - sizeof(GraphCacheHeader));
+	memcpy(buffer.data(), &fileHeader, sizeof(fileHeader));
+
+	std::string temporaryName = fileName + ".tmp";
+	std::ofstream output(temporaryName, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!output.is_open())
+		return false;
+
+	output.write(buffer.data(), buffer.size());
+	output.close();
+
+	std::remove(fileName.c_str()); // rename doesn't replace a file on Windows
+	if (!output || std::rename(temporaryName.c_str(), fileName.c_str()) != 0) {
+		std::remove(temporaryName.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+inline bool GraphCache::WriteSourceStamp(const std::string& fileName, const FileStamp& sourceStamp) {
+	std::fstream cacheFile(fileName, std::ios::in | std::ios::out | std::ios::binary);
+	if (!cacheFile.is_open())
+		return false;
+
+	GraphCacheHeader fileHeader;
+	if (!cacheFile.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader)) ||
+		memcmp(fileHeader.magic, "CITYGRPH", 8) != 0 || fileHeader.version != VERSION)
+		return false;
+
+	// The checksum doesn't cover the header, the rest of the file stays valid
+	fileHeader.sourceSize = sourceStamp.size;
+	fileHeader.sourceModified = sourceStamp.modified;
+
+	cacheFile.seekp(0);
+	cacheFile.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+	return static_cast<bool>(cacheFile);
+}
+
+inline bool GraphCache::Open(const std::string& fileName) {
+	Close();
+
+	file = std::make_shared<MappedFile>();
+	if (!file->Open(fileName) || file->GetSize() < sizeof(GraphCacheHeader)) {
+		file.reset();
+		return false;
+	}
+
+	const GraphCacheHeader* fileHeader = reinterpret_cast<const GraphCacheHeader*>(file->GetData());
+	size_t cityCount = fileHeader->cityCount;
+	size_t wordCount = (cityCount + 63) / 64;
+
+	bool valid = memcmp(fileHeader->magic, "CITYGRPH", 8) == 0 && fileHeader->version == VERSION &&
+		fileHeader->fileSize == file->GetSize() && cityCount > 0 &&
+		fileHeader->namesOffset == sizeof(GraphCacheHeader) &&
+		fileHeader->distancesOffset >= fileHeader->namesOffset + (cityCount + 1) * sizeof(uint32_t) &&
+		fileHeader->bandsOffset == Align(fileHeader->distancesOffset + cityCount * cityCount * sizeof(uint16_t)) &&
+		fileHeader->fileSize == fileHeader->bandsOffset + fileHeader->bandCount * (2 * sizeof(int32_t) + cityCount * wordCount * sizeof(uint64_t));
+
+	if (!valid || HashBytes(file->GetData() + sizeof(GraphCacheHeader), file->GetSize() - sizeof(GraphCacheHeader)) != fileHeader->checksum) {
+		file.reset();
+		return false;
+	}
+
+	header = fileHeader;
+	return true;
+}
+
+inline void GraphCache::Close() {
+	file.reset(); // Unmapped when the last graph loaded from it is gone too
+	header = NULL;
+}
+
+inline bool GraphCache::Load(std::unique_ptr<RuntimeGraph>& graph) {
+	if (!IsOpen())
+		return false;
+
+	size_t cityCount = header->cityCount;
+	const char* data = file->GetData();
+	const uint32_t* nameOffsets = reinterpret_cast<const uint32_t*>(data + header->namesOffset);
+	const char* names = reinterpret_cast<const char*>(nameOffsets + cityCount + 1);
+	const uint16_t* distances = reinterpret_cast<const uint16_t*>(data + header->distancesOffset);
+
+	graph.reset(new RuntimeGraph(static_cast<int>(cityCount), distances, file));
+
+	for (size_t i = 0; i < cityCount; ++i)
+		graph->GetNames()[i].assign(names + nameOffsets[i], names + nameOffsets[i + 1]);
+
+	return true;
+}
+
+inline const uint64_t* GraphCache::FindBand(int low, int high) const {
+	if (!IsOpen())
+		return NULL;
+
+	size_t bandBytes = 2 * sizeof(int32_t) + header->cityCount * ((header->cityCount + 63) / 64) * sizeof(uint64_t);
+	const char* band = file->GetData() + header->bandsOffset;
+
+	for (uint32_t b = 0; b < header->bandCount; ++b, band += bandBytes) {
+		int32_t limits[2];
+		memcpy(limits, band, sizeof(limits));
+
+		if (limits[0] == low && limits[1] == high)
+			return reinterpret_cast<const uint64_t*>(band + sizeof(limits));
+	}
+
+	return NULL;
+}
+
+inline bool GraphCache::LoadBand(RuntimeGraph& graph, int low, int high) const {
+	const uint64_t* words = FindBand(low, high);
+
+	if (words == NULL || graph.GetCityCount() != GetCityCount())
+		return false;
+
+	graph.SetBand(words);
+	return true;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <StaticBitsetLibrary.h>
+#include <StaticVectorLibrary.h>
+#include <BitAdjacency.h>
+
+// All pairs hop distances of a graph. A row is computed with a BFS over bit rows where a whole
+// level is expanded by OR'ing the rows of the frontier. Rows are computed when they are first
+// needed and removing a city only invalidates the rows of the cities which could reach it.
+template <unsigned int N>
+class HopDistanceTable {
+public:
+	static const unsigned short UNREACHABLE = 0xFFFF;
+
+	HopDistanceTable();
+
+	// Takes the graph, non zero entries are edges. Rows are computed lazily.
+	template <class T>
+	void Build(StaticVector<StaticVector<T, N>, N>& graph);
+	void Build(const BitAdjacency<N>& graph);
+
+	// Computes every row now instead of on the first query
+	void ComputeAll();
+
+	// Removes every edge of the city and invalidates the rows whose distances may change
+	void RemoveVertex(int vertex);
+
+	// Hop count between two cities, UNREACHABLE if there is no path
+	int Distance(int from, int to);
+
+	// Sum of the distances from the city to every city it can reach
+	int DistanceSum(int from);
+
+	const BitAdjacency<N>& GetAdjacency() const { return adjacency; }
+
+private:
+	void ComputeRow(int source);
+
+	BitAdjacency<N> adjacency;
+	unsigned short distances[N][N];
+	int distanceSums[N];
+	bool rowValid[N];
+};
+
+template <unsigned int N>
+HopDistanceTable<N>::HopDistanceTable() {
+	for (int i = 0; i < N; ++i)
+		rowValid[i] = false;
+}
+
+template <unsigned int N>
+template <class T>
+void HopDistanceTable<N>::Build(StaticVector<StaticVector<T, N>, N>& graph) {
+	adjacency.Build(graph);
+
+	for (int i = 0; i < N; ++i)
+		rowValid[i] = false;
+}
+
+template <unsigned int N>
+void HopDistanceTable<N>::Build(const BitAdjacency<N>& graph) {
+	adjacency = graph;
+
+	for (int i = 0; i < N; ++i)
+		rowValid[i] = false;
+}
+
+template <unsigned int N>
+void HopDistanceTable<N>::ComputeAll() {
+	for (int i = 0; i < N; ++i) {
+		if (!rowValid[i])
+			ComputeRow(i);
+	}
+}
+
+template <unsigned int N>
+void HopDistanceTable<N>::RemoveVertex(int vertex) {
+	// A row can only change if its source reached the vertex, the other rows stay valid
+	for (int i = 0; i < N; ++i) {
+		if (rowValid[i] && distances[i][vertex] != UNREACHABLE)
+			rowValid[i] = false;
+	}
+
+	rowValid[vertex] = false;
+	adjacency.RemoveVertex(vertex);
+}
+
+template <unsigned int N>
+int HopDistanceTable<N>::Distance(int from, int to) {
+	if (!rowValid[from])
+		ComputeRow(from);
+
+	return distances[from][to];
+}
+
+template <unsigned int N>
+int HopDistanceTable<N>::DistanceSum(int from) {
+	if (!rowValid[from])
+		ComputeRow(from);
+
+	return distanceSums[from];
+}
+
+template <unsigned int N>
+void HopDistanceTable<N>::ComputeRow(int source) {
+	unsigned short* row = distances[source];
+
+	for (int i = 0; i < N; ++i)
+		row[i] = UNREACHABLE;
+
+	StaticBitset<N> seen;
+	StaticBitset<N> frontier;
+	seen.Set(source);
+	frontier.Set(source);
+	row[source] = 0;
+
+	int sum = 0;
+	unsigned short level = 0;
+
+	while (frontier.Any()) {
+		level++;
+
+		// Every city one hop away from the frontier which wasn't seen before
+		StaticBitset<N> next;
+		for (int i = frontier.FindFirst(); i != -1; i = frontier.FindNext(i))
+			next |= adjacency.Row(i);
+		next.AndNot(seen);
+
+		for (int i = next.FindFirst(); i != -1; i = next.FindNext(i)) {
+			row[i] = level;
+			sum += level;
+		}
+
+		seen |= next;
+		frontier = next;
+	}
+
+	distanceSums[source] = sum;
+	rowValid[source] = true;
+}
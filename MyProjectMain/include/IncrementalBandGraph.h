@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <StaticVectorLibrary.h>
+#include <BitAdjacency.h>
+
+// Every city pair with a distance, sorted by distance once so a distance band is a contiguous range
+template <unsigned int N>
+class SortedCityPairs {
+public:
+	struct CityPair {
+		int distance;
+		int from;
+		int to;
+	};
+
+	SortedCityPairs() : pairCount(0) {
+	}
+
+	void Build(StaticVector<StaticVector<int, N>, N>& distances);
+
+	int GetSize() const { return pairCount; }
+	const CityPair& operator[](int index) const { return pairs[index]; }
+
+private:
+	CityPair pairs[N * N];
+	int pairCount;
+};
+
+// Graph of the pairs whose distance is in [low, high], same graph CreateGraph produces for
+// distance - tolerance and distance + tolerance. Moving the band only adds or removes the pairs
+// between the old and new band edges, the matrix and the bit rows are updated for those pairs only.
+template <unsigned int N>
+class IncrementalBandGraph {
+public:
+	explicit IncrementalBandGraph(const SortedCityPairs<N>& pairs);
+
+	void SetBand(int low, int high);
+
+	StaticVector<StaticVector<int, N>, N>& GetGraph() { return graph; }
+	const BitAdjacency<N>& GetAdjacency() const { return adjacency; }
+	int GetEdgeCount() const { return highIndex - lowIndex; }
+
+private:
+	// Index of the first pair with distance >= value, walking from the current index
+	int MoveLowerIndex(int index, int value) const;
+	// Index of the first pair with distance > value, walking from the current index
+	int MoveUpperIndex(int index, int value) const;
+
+	void AddPair(int index);
+	void RemovePair(int index);
+
+	const SortedCityPairs<N>& pairs;
+	StaticVector<StaticVector<int, N>, N> graph;
+	BitAdjacency<N> adjacency;
+
+	// Pairs in [lowIndex, highIndex) are in the graph
+	int lowIndex;
+	int highIndex;
+};
+
+template <unsigned int N>
+void SortedCityPairs<N>::Build(StaticVector<StaticVector<int, N>, N>& distances) {
+	pairCount = 0;
+
+	for (int i = 0; i < N; ++i) {
+		for (int j = 0; j < N; ++j) {
+			if (distances[i][j] == 0) // Zero is no path for CreateGraph too
+				continue;
+
+			pairs[pairCount].distance = distances[i][j];
+			pairs[pairCount].from = i;
+			pairs[pairCount].to = j;
+			pairCount++;
+		}
+	}
+
+	std::sort(pairs, pairs + pairCount, [](const CityPair& lhs, const CityPair& rhs) {
+		return lhs.distance < rhs.distance;
+	});
+}
+
+template <unsigned int N>
+IncrementalBandGraph<N>::IncrementalBandGraph(const SortedCityPairs<N>& cityPairs) : pairs(cityPairs), lowIndex(0), highIndex(0) {
+	for (int i = 0; i < N; ++i) {
+		for (int j = 0; j < N; ++j)
+			graph[i][j] = 0;
+	}
+}
+
+template <unsigned int N>
+int IncrementalBandGraph<N>::MoveLowerIndex(int index, int value) const {
+	while (index < pairs.GetSize() && pairs[index].distance < value)
+		index++;
+	while (index > 0 && pairs[index - 1].distance >= value)
+		index--;
+
+	return index;
+}
+
+template <unsigned int N>
+int IncrementalBandGraph<N>::MoveUpperIndex(int index, int value) const {
+	while (index < pairs.GetSize() && pairs[index].distance <= value)
+		index++;
+	while (index > 0 && pairs[index - 1].distance > value)
+		index--;
+
+	return index;
+}
+
+template <unsigned int N>
+void IncrementalBandGraph<N>::SetBand(int low, int high) {
+	int newLowIndex = MoveLowerIndex(lowIndex, low);
+	int newHighIndex = MoveUpperIndex(highIndex, high);
+
+	if (newHighIndex < newLowIndex) // Empty band
+		newHighIndex = newLowIndex;
+
+	if (newLowIndex >= highIndex || newHighIndex <= lowIndex) { // Ranges don't overlap, replacing every pair
+		for (int i = lowIndex; i < highIndex; ++i)
+			RemovePair(i);
+		for (int i = newLowIndex; i < newHighIndex; ++i)
+			AddPair(i);
+	}
+	else {
+		// Only the pairs between the old and the new edges of the range change
+		for (int i = lowIndex; i < newLowIndex; ++i)
+			RemovePair(i);
+		for (int i = newLowIndex; i < lowIndex; ++i)
+			AddPair(i);
+		for (int i = newHighIndex; i < highIndex; ++i)
+			RemovePair(i);
+		for (int i = highIndex; i < newHighIndex; ++i)
+			AddPair(i);
+	}
+
+	lowIndex = newLowIndex;
+	highIndex = newHighIndex;
+}
+
+template <unsigned int N>
+void IncrementalBandGraph<N>::AddPair(int index) {
+	const typename SortedCityPairs<N>::CityPair& pair = pairs[index];
+
+	graph[pair.from][pair.to] = pair.distance;
+	adjacency.AddArc(pair.from, pair.to);
+}
+
+template <unsigned int N>
+void IncrementalBandGraph<N>::RemovePair(int index) {
+	const typename SortedCityPairs<N>::CityPair& pair = pairs[index];
+
+	graph[pair.from][pair.to] = 0;
+	adjacency.RemoveArc(pair.from, pair.to);
+}
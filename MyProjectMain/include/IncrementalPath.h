@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstring>
+#include <BitAdjacency.h>
+#include <StaticBitsetLibrary.h>
+
+// Gene array of a path with the validity of every consecutive pair cached. Edge i is the pair at positions
+// i and i + 1, its bit is set when the pair is not a band edge. Attach checks every pair once, after that
+// Swap, Insert and Erase only check the pairs they touch, so the fitness is known in O(1) after a change.
+// The genes belong to the caller, they must only be changed through this object while it is attached.
+template <class T, unsigned int N>
+class IncrementalPath {
+public:
+	IncrementalPath() : band(NULL), genes(NULL), length(0), invalidCount(0) {
+	}
+
+	void Attach(const BitAdjacency<N>& pathBand, T* pathGenes, int pathLength) {
+		band = &pathBand;
+		genes = pathGenes;
+		length = pathLength;
+		invalidEdges.Clear();
+		invalidCount = 0;
+
+		for (int edge = 0; edge < length - 1; ++edge)
+			CheckEdge(edge);
+	}
+
+	int GetLength() const { return length; }
+	int GetInvalidCount() const { return invalidCount; }
+
+	// Same as CalculateFitness, the pair count or -1 when a pair is outside the band
+	int GetFitness() const {
+		if (invalidCount > 0)
+			return -1;
+
+		return length > 0 ? length - 1 : 0;
+	}
+
+	// Genes before the first pair outside the band
+	int GetValidPrefixLength() const {
+		int edge = invalidEdges.FindFirst();
+		return edge == -1 ? length : edge + 1;
+	}
+
+	void PushBack(T city) {
+		genes[length++] = city;
+		if (length > 1)
+			CheckEdge(length - 2);
+	}
+
+	// Swaps two genes, at most 4 pairs are checked again
+	void Swap(int first, int second) {
+		if (first == second)
+			return;
+
+		int edges[4] = { first - 1, first, second - 1, second };
+		for (int i = 0; i < 4; ++i) {
+			if (IsEdge(edges[i]) && !IsRepeated(edges, i))
+				ForgetEdge(edges[i]);
+		}
+
+		T temp = genes[first];
+		genes[first] = genes[second];
+		genes[second] = temp;
+
+		for (int i = 0; i < 4; ++i) {
+			if (IsEdge(edges[i]) && !IsRepeated(edges, i))
+				CheckEdge(edges[i]);
+		}
+	}
+
+	// Inserts city before position, position can be the length to append. The genes after it move by one.
+	void Insert(int position, T city) {
+		if (IsEdge(position - 1))
+			ForgetEdge(position - 1);
+		ShiftEdgesUp(position);
+
+		std::memmove(genes + position + 1, genes + position, (length - position) * sizeof(T));
+		genes[position] = city;
+		length++;
+
+		if (IsEdge(position - 1))
+			CheckEdge(position - 1);
+		if (IsEdge(position))
+			CheckEdge(position);
+	}
+
+	// Removes the gene at position, the genes after it move by one
+	void Erase(int position) {
+		if (IsEdge(position - 1))
+			ForgetEdge(position - 1);
+		if (IsEdge(position))
+			ForgetEdge(position);
+		ShiftEdgesDown(position);
+
+		std::memmove(genes + position, genes + position + 1, (length - position - 1) * sizeof(T));
+		length--;
+
+		if (IsEdge(position - 1))
+			CheckEdge(position - 1);
+	}
+
+private:
+	bool IsEdge(int edge) const {
+		return edge >= 0 && edge < length - 1;
+	}
+
+	static bool IsRepeated(const int* edges, int index) {
+		for (int i = 0; i < index; ++i) {
+			if (edges[i] == edges[index])
+				return true;
+		}
+		return false;
+	}
+
+	void CheckEdge(int edge) {
+		if (!band->HasEdge(genes[edge], genes[edge + 1])) {
+			invalidEdges.Set(edge);
+			invalidCount++;
+		}
+	}
+
+	void ForgetEdge(int edge) {
+		if (invalidEdges.Test(edge)) {
+			invalidEdges.Reset(edge);
+			invalidCount--;
+		}
+	}
+
+	// Moves the bits from index from up by one, bit from becomes zero. Words are moved from the top so a
+	// word is read before it changes.
+	void ShiftEdgesUp(int from) {
+		const int WORD_BITS = StaticBitset<N>::WORD_BITS;
+		int firstWord = from / WORD_BITS;
+
+		for (int word = StaticBitset<N>::WORD_COUNT - 1; word > firstWord; --word)
+			invalidEdges.SetWord(word, (invalidEdges.GetWord(word) << 1) | (invalidEdges.GetWord(word - 1) >> (WORD_BITS - 1)));
+
+		uint64_t lowMask = (1ULL << (from % WORD_BITS)) - 1;
+		uint64_t word = invalidEdges.GetWord(firstWord);
+		invalidEdges.SetWord(firstWord, (word & lowMask) | ((word & ~lowMask) << 1));
+	}
+
+	// Moves the bits above from down by one over bit from, which has to be zero
+	void ShiftEdgesDown(int from) {
+		const int WORD_BITS = StaticBitset<N>::WORD_BITS;
+		int firstWord = from / WORD_BITS;
+
+		uint64_t lowMask = (1ULL << (from % WORD_BITS)) - 1;
+		for (int word = firstWord; word < StaticBitset<N>::WORD_COUNT; ++word) {
+			uint64_t value = invalidEdges.GetWord(word);
+			uint64_t carry = word + 1 < StaticBitset<N>::WORD_COUNT ? invalidEdges.GetWord(word + 1) & 1ULL : 0;
+			uint64_t shifted = (value >> 1) | (carry << (WORD_BITS - 1));
+
+			if (word == firstWord)
+				shifted = (value & lowMask) | (shifted & ~lowMask);
+
+			invalidEdges.SetWord(word, shifted);
+		}
+	}
+
+	const BitAdjacency<N>* band;
+	T* genes;
+	int length;
+	StaticBitset<N> invalidEdges;
+	int invalidCount;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+// Frames of an iterative depth first search on N cities. A frame is a vertex and the last neighbor tried from
+// it, the vertices of the frames from the bottom are the current path, so the path buffer is shared by every
+// frame and grows and shrinks with Push and Pop. Nothing is allocated while searching.
+template <unsigned int N>
+class DfsStack {
+public:
+	DfsStack() : depth(0) {
+	}
+
+	void Clear() { depth = 0; }
+	bool IsEmpty() const { return depth == 0; }
+	int GetDepth() const { return depth; }
+
+	void Push(int vertex) {
+		path[depth] = vertex;
+		lastNeighbors[depth] = -1;
+		depth++;
+	}
+
+	void Pop() { depth--; }
+
+	int Top() const { return path[depth - 1]; }
+
+	// Neighbor of the top frame tried last, -1 before the first one
+	int& LastNeighbor() { return lastNeighbors[depth - 1]; }
+
+	// Vertices of the frames, the start first
+	const int* GetPath() const { return path; }
+
+private:
+	int path[N];
+	int lastNeighbors[N];
+	int depth;
+};
+
+// Depth first search from start without recursion. The visitor decides the order and visits like the
+// recursive searches did:
+//   bool Enter(int vertex)                 the vertex gets a frame, false stops the search
+//   int NextNeighbor(int vertex, int last) next neighbor after last to enter, -1 when the vertex is done
+//   void Leave(int vertex)                 the frame of the vertex is popped
+//   void Returned(int parent, int child)   the search is back in parent after child was left
+// Returns false when Enter stopped the search, the frames of the stopped search are left on the stack.
+template <unsigned int N, class Visitor>
+bool RunDfs(int start, DfsStack<N>& stack, Visitor& visitor) {
+	stack.Clear();
+
+	if (!visitor.Enter(start))
+		return false;
+	stack.Push(start);
+
+	while (!stack.IsEmpty()) {
+		int vertex = stack.Top();
+		int neighbor = visitor.NextNeighbor(vertex, stack.LastNeighbor());
+
+		if (neighbor != -1) {
+			stack.LastNeighbor() = neighbor;
+			if (!visitor.Enter(neighbor))
+				return false;
+
+			stack.Push(neighbor);
+			continue;
+		}
+
+		visitor.Leave(vertex);
+		stack.Pop();
+
+		if (!stack.IsEmpty())
+			visitor.Returned(stack.Top(), vertex);
+	}
+
+	return true;
+}
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <cmath>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <BitAdjacency.h>
+#include <StaticBitsetLibrary.h>
+#include <RandomGenerator.h>
+
+// Local search on a path of cities in a distance band. Every move keeps the path valid and is checked with
+// at most two bit tests, the score of a path is its city count so the change of a move is known before it
+// is applied. The first city never moves.
+//
+// Moves:
+//   insert   a city which is not on the path goes between two neighbors that are both band neighbors of it
+//   reverse  2-opt, the segment between two positions is reversed when both new pairs are band edges
+//   replace  a segment of up to maxSegment cities is replaced by one city, or removed when its ends can
+//            be joined or it is the tail of the path
+enum LocalSearchMethod {
+	LOCAL_SEARCH_ANNEALING,        // Worse paths are accepted with exp(change / temperature)
+	LOCAL_SEARCH_LATE_ACCEPTANCE   // A path is accepted when it is not worse than the path historyLength moves ago
+};
+
+enum CoolingSchedule {
+	COOLING_GEOMETRIC, // Temperature falls by the same factor every move
+	COOLING_LINEAR
+};
+
+struct LocalSearchConfig {
+	int method = LOCAL_SEARCH_ANNEALING;
+	int schedule = COOLING_GEOMETRIC;
+	double startTemperature = 2.0;     // Losing one city is accepted with exp(-1 / temperature)
+	double endTemperature = 0.05;
+	int iterations = 1000;
+	double timeBudgetMilliseconds = 0; // The search also stops when the budget is used, 0 means no budget
+	int historyLength = 50;            // Late acceptance
+	int maxSegment = 3;                // Longest segment a replace move removes
+	double insertRate = 0.4;           // Share of insert moves, reverse moves get reverseRate and the rest replace
+	double reverseRate = 0.3;
+};
+
+struct LocalSearchResult {
+	int startFitness = 0;
+	int bestFitness = 0;
+	int iterations = 0;
+	int acceptedMoves = 0;
+	double milliseconds = 0;
+};
+
+template <class T, unsigned int N>
+class LocalSearch {
+public:
+	// Improves the path in genes, which has room for N cities, and leaves the best path found in it.
+	// members has to hold the cities of the path. A path with pairs outside the band is cut before the first one.
+	LocalSearchResult Run(const BitAdjacency<N>& band, const LocalSearchConfig& config, T* genes, int& length,
+		StaticBitset<N>& members, RandomGenerator& random);
+
+private:
+	enum MoveType { MOVE_INSERT, MOVE_REVERSE, MOVE_REPLACE };
+
+	struct Move {
+		int type;
+		int first;  // First position the move changes
+		int last;   // Last position of a reversed or replaced segment
+		int city;   // Inserted or replacing city, -1 when a segment is only removed
+		int change; // Change of the city count
+	};
+
+	bool ProposeInsert(const BitAdjacency<N>& band, const T* genes, int length, const StaticBitset<N>& members,
+		RandomGenerator& random, Move& move) const;
+	bool ProposeReverse(const BitAdjacency<N>& band, const T* genes, int length, RandomGenerator& random, Move& move) const;
+	bool ProposeReplace(const BitAdjacency<N>& band, const LocalSearchConfig& config, const T* genes, int length,
+		const StaticBitset<N>& members, RandomGenerator& random, Move& move) const;
+
+	void Apply(const Move& move, T* genes, int& length, StaticBitset<N>& members) const;
+
+	static double Temperature(const LocalSearchConfig& config, double progress);
+
+	T bestGenes[N];
+	std::vector<int> history;
+};
+
+template <class T, unsigned int N>
+LocalSearchResult LocalSearch<T, N>::Run(const BitAdjacency<N>& band, const LocalSearchConfig& config, T* genes, int& length,
+	StaticBitset<N>& members, RandomGenerator& random) {
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	LocalSearchResult result;
+
+	int validLength = 1;
+	while (validLength < length && band.HasEdge(genes[validLength - 1], genes[validLength]))
+		validLength++;
+	for (int i = validLength; i < length; ++i)
+		members.Reset(genes[i]);
+	length = validLength;
+
+	int bestLength = length;
+	std::memcpy(bestGenes, genes, length * sizeof(T));
+	result.startFitness = length - 1;
+
+	if (config.method == LOCAL_SEARCH_LATE_ACCEPTANCE)
+		history.assign(std::max(config.historyLength, 1), length);
+
+	double temperature = config.startTemperature;
+	double progress = 0;
+
+	for (int iteration = 0; iteration < config.iterations; ++iteration) {
+		if (config.timeBudgetMilliseconds > 0 && (iteration & 255) == 0) {
+			double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			if (elapsed >= config.timeBudgetMilliseconds)
+				break;
+			progress = std::max(progress, elapsed / config.timeBudgetMilliseconds);
+		}
+
+		progress = std::max(progress, static_cast<double>(iteration) / config.iterations);
+		result.iterations++;
+
+		Move move;
+		double kind = random.NextDouble();
+		bool found = false;
+		if (kind < config.insertRate)
+			found = ProposeInsert(band, genes, length, members, random, move);
+		else if (kind < config.insertRate + config.reverseRate)
+			found = ProposeReverse(band, genes, length, random, move);
+		else
+			found = ProposeReplace(band, config, genes, length, members, random, move);
+
+		if (!found)
+			continue;
+
+		bool accepted = false;
+		if (config.method == LOCAL_SEARCH_LATE_ACCEPTANCE) {
+			int& previous = history[iteration % history.size()];
+			int candidate = length + move.change;
+
+			accepted = move.change >= 0 || candidate >= previous;
+			previous = accepted ? candidate : length;
+		}
+		else {
+			temperature = Temperature(config, progress);
+			accepted = move.change >= 0 || random.NextDouble() < std::exp(move.change / temperature);
+		}
+
+		if (!accepted)
+			continue;
+
+		Apply(move, genes, length, members);
+		result.acceptedMoves++;
+
+		if (length > bestLength) {
+			bestLength = length;
+			std::memcpy(bestGenes, genes, length * sizeof(T));
+		}
+	}
+
+	// The path ends as the best one found
+	std::memcpy(genes, bestGenes, bestLength * sizeof(T));
+	length = bestLength;
+	members.Clear();
+	for (int i = 0; i < length; ++i)
+		members.Set(genes[i]);
+
+	result.bestFitness = length - 1;
+	result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+template <class T, unsigned int N>
+bool LocalSearch<T, N>::ProposeInsert(const BitAdjacency<N>& band, const T* genes, int length, const StaticBitset<N>& members,
+	RandomGenerator& random, Move& move) const {
+
+	if (length >= static_cast<int>(N))
+		return false;
+
+	int position = random.NextInt(1, length + 1); // Appending when it is length
+	StaticBitset<N> candidates = band.Row(genes[position - 1]);
+	candidates.AndNot(members);
+	if (position < length)
+		candidates &= band.Row(genes[position]);
+
+	int count = candidates.Count();
+	if (count == 0)
+		return false;
+
+	move.type = MOVE_INSERT;
+	move.first = position;
+	move.last = position;
+	move.city = candidates.Select(random.NextInt(0, count));
+	move.change = 1;
+	return true;
+}
+
+template <class T, unsigned int N>
+bool LocalSearch<T, N>::ProposeReverse(const BitAdjacency<N>& band, const T* genes, int length, RandomGenerator& random, Move& move) const {
+	if (length < 3)
+		return false;
+
+	int first = random.NextInt(1, length);
+	int last = random.NextInt(1, length);
+	if (first > last)
+		std::swap(first, last);
+
+	if (first == last || !band.HasEdge(genes[first - 1], genes[last]))
+		return false;
+	if (last + 1 < length && !band.HasEdge(genes[first], genes[last + 1]))
+		return false;
+
+	move.type = MOVE_REVERSE;
+	move.first = first;
+	move.last = last;
+	move.city = -1;
+	move.change = 0;
+	return true;
+}
+
+template <class T, unsigned int N>
+bool LocalSearch<T, N>::ProposeReplace(const BitAdjacency<N>& band, const LocalSearchConfig& config, const T* genes, int length,
+	const StaticBitset<N>& members, RandomGenerator& random, Move& move) const {
+
+	if (length < 2)
+		return false;
+
+	int first = random.NextInt(1, length);
+	int last = std::min(first + random.NextInt(0, std::max(config.maxSegment, 1)), length - 1);
+	int removed = last - first + 1;
+	bool tail = last + 1 == length;
+
+	StaticBitset<N> candidates = band.Row(genes[first - 1]);
+	candidates.AndNot(members);
+	if (!tail)
+		candidates &= band.Row(genes[last + 1]);
+
+	int count = candidates.Count();
+	move.type = MOVE_REPLACE;
+	move.first = first;
+	move.last = last;
+
+	if (count > 0) {
+		move.city = candidates.Select(random.NextInt(0, count));
+		move.change = 1 - removed;
+		return true;
+	}
+
+	if (tail || band.HasEdge(genes[first - 1], genes[last + 1])) {
+		move.city = -1;
+		move.change = -removed;
+		return true;
+	}
+
+	return false;
+}
+
+template <class T, unsigned int N>
+void LocalSearch<T, N>::Apply(const Move& move, T* genes, int& length, StaticBitset<N>& members) const {
+	switch (move.type) {
+	case MOVE_INSERT:
+		std::memmove(genes + move.first + 1, genes + move.first, (length - move.first) * sizeof(T));
+		genes[move.first] = move.city;
+		members.Set(move.city);
+		length++;
+		break;
+	case MOVE_REVERSE:
+		std::reverse(genes + move.first, genes + move.last + 1);
+		break;
+	default: {
+		for (int i = move.first; i <= move.last; ++i)
+			members.Reset(genes[i]);
+
+		int next = move.first;
+		if (move.city != -1) {
+			genes[next++] = move.city;
+			members.Set(move.city);
+		}
+
+		std::memmove(genes + next, genes + move.last + 1, (length - move.last - 1) * sizeof(T));
+		length += move.change;
+		break;
+	}
+	}
+}
+
+template <class T, unsigned int N>
+double LocalSearch<T, N>::Temperature(const LocalSearchConfig& config, double progress) {
+	progress = std::min(progress, 1.0);
+
+	if (config.schedule == COOLING_LINEAR)
+		return config.startTemperature + (config.endTemperature - config.startTemperature) * progress;
+
+	return config.startTemperature * std::pow(config.endTemperature / config.startTemperature, progress);
+}
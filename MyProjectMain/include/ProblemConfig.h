@@ -0,0 +1,20 @@
+#pragma once
+
+// Size and distance band of the 81 city dataset. Every source file takes them from here so they can't
+// disagree, they can be overridden from the build with -DCITY_COUNT=... and so on.
+// Distance tables of other sizes don't need a rebuild, they are read into a RuntimeGraph.
+#ifndef CITY_COUNT
+#define CITY_COUNT 81
+#endif
+
+#ifndef START
+#define START 5
+#endif
+
+#ifndef DISTANCE
+#define DISTANCE 250
+#endif
+
+#ifndef TOLERANCE
+#define TOLERANCE 50
+#endif
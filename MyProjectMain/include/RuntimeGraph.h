@@ -0,0 +1,234 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include <StaticBitsetLibrary.h>
+#include <BandFilter.h>
+
+// One contiguous block handed out front to back. Nothing is freed on its own, the whole block goes with the arena.
+class GraphArena {
+public:
+	explicit GraphArena(size_t bytes) : block(new unsigned char[bytes]), capacity(bytes), used(0) {
+	}
+
+	// Returns NULL if the arena doesn't have room for count elements
+	template <class T>
+	T* Allocate(size_t count) {
+		size_t alignment = alignof(T);
+		size_t start = (used + alignment - 1) / alignment * alignment;
+
+		if (start + count * sizeof(T) > capacity)
+			return NULL;
+
+		used = start + count * sizeof(T);
+		return reinterpret_cast<T*>(block.get() + start);
+	}
+
+	size_t GetUsedBytes() const { return used; }
+	size_t GetCapacity() const { return capacity; }
+
+private:
+	std::unique_ptr<unsigned char[]> block;
+	size_t capacity;
+	size_t used;
+};
+
+// Path of cities with a capacity fixed when it is created, the storage belongs to an arena
+class CityPath {
+public:
+	CityPath() : cities(NULL), size(0), capacity(0) {
+	}
+
+	CityPath(int* storage, int pathCapacity) : cities(storage), size(0), capacity(pathCapacity) {
+	}
+
+	bool PushBack(int city) {
+		if (size == capacity)
+			return false;
+
+		cities[size++] = city;
+		return true;
+	}
+
+	bool PopBack() {
+		if (size == 0)
+			return false;
+
+		size--;
+		return true;
+	}
+
+	void Clear() { size = 0; }
+	int GetSize() const { return size; }
+	int GetCapacity() const { return capacity; }
+
+	int& operator[](int index) { return cities[index]; }
+	int operator[](int index) const { return cities[index]; }
+
+	friend std::ostream& operator<<(std::ostream& os, const CityPath& path) {
+		for (int i = 0; i < path.size; i++)
+			os << path.cities[i] << " ";
+
+		os << std::endl;
+		return os;
+	}
+
+private:
+	int* cities;
+	int size;
+	int capacity;
+};
+
+// Distance table whose city count is known at runtime. The bit rows of the band filtered graph, a second set of
+// bit rows the searches can modify, the path buffers and the distances are all in one arena. A table read from a
+// GraphCache reads its 16 bit distances from the mapped cache instead, which it keeps mapped while it lives.
+class RuntimeGraph {
+public:
+	RuntimeGraph(int cities, int pathCount = 4);
+	RuntimeGraph(int cities, const uint16_t* cachedDistances, std::shared_ptr<const void> distanceOwner, int pathCount = 4);
+
+	int GetCityCount() const { return cityCount; }
+	int GetWordCount() const { return wordCount; }
+
+	int Distance(int from, int to) const {
+		size_t index = static_cast<size_t>(from) * cityCount + to;
+		return distances != NULL ? distances[index] : sharedDistances[index];
+	}
+
+	// Row to write the distances to, only for a table which owns its distances
+	int* DistanceRow(int city) { return distances + static_cast<size_t>(city) * cityCount; }
+	bool OwnsDistances() const { return distances != NULL; }
+
+	// Row of the distances, the 16 bit rows of a shared table are widened into buffer, which has room for a row
+	const int* ReadDistanceRow(int city, int* buffer) const;
+
+	// Filters the distances to [low, high] with the shared band filter kernel and builds the bit rows
+	void FilterBand(int low, int high);
+
+	// Same as FilterBand from bit rows that were computed before, like the bands of a GraphCache
+	void SetBand(const uint64_t* words);
+
+	// Graph of the last FilterBand, zero is no edge
+	int Edge(int from, int to) const {
+		return ((BitRow(from)[to / 64] >> (to % 64)) & 1ULL) ? Distance(from, to) : 0;
+	}
+	const uint64_t* BitRow(int city) const { return bitRows + static_cast<size_t>(city) * wordCount; }
+	int Degree(int city) const;
+
+	// Bit rows searches remove cities from, ResetWorkRows copies the filtered graph's rows back
+	uint64_t* WorkRow(int city) { return workRows + static_cast<size_t>(city) * wordCount; }
+	void ResetWorkRows();
+
+	// Path with room for every city, at most pathCount paths can be created
+	CityPath CreatePath();
+
+	std::vector<std::string>& GetNames() { return names; }
+	const std::vector<std::string>& GetNames() const { return names; }
+
+	size_t GetArenaBytes() const { return arena.GetUsedBytes(); }
+
+private:
+	static size_t ArenaSize(int cities, int pathCount, bool ownsDistances);
+	void AllocateRows();
+
+	int cityCount;
+	int wordCount;
+	GraphArena arena;
+	int* distances; // NULL when the distances are shared
+	const uint16_t* sharedDistances;
+	std::shared_ptr<const void> sharedDistanceOwner;
+	uint64_t* bitRows;
+	uint64_t* workRows;
+	std::vector<std::string> names;
+};
+
+inline size_t RuntimeGraph::ArenaSize(int cities, int pathCount, bool ownsDistances) {
+	size_t matrix = ownsDistances ? static_cast<size_t>(cities) * cities * sizeof(int) : 0;
+	size_t rows = static_cast<size_t>(cities) * ((cities + 63) / 64) * sizeof(uint64_t);
+	size_t paths = static_cast<size_t>(pathCount) * cities * sizeof(int);
+
+	return matrix + 2 * rows + paths + 64; // 64 bytes for alignment
+}
+
+inline RuntimeGraph::RuntimeGraph(int cities, int pathCount) : cityCount(cities), wordCount((cities + 63) / 64),
+	arena(ArenaSize(cities, pathCount, true)), sharedDistances(NULL), names(cities) {
+
+	AllocateRows();
+
+	size_t cells = static_cast<size_t>(cityCount) * cityCount;
+	distances = arena.Allocate<int>(cells);
+	for (size_t i = 0; i < cells; ++i)
+		distances[i] = 0;
+}
+
+inline RuntimeGraph::RuntimeGraph(int cities, const uint16_t* cachedDistances, std::shared_ptr<const void> distanceOwner, int pathCount)
+	: cityCount(cities), wordCount((cities + 63) / 64), arena(ArenaSize(cities, pathCount, false)), distances(NULL),
+	sharedDistances(cachedDistances), sharedDistanceOwner(distanceOwner), names(cities) {
+
+	AllocateRows();
+}
+
+inline void RuntimeGraph::AllocateRows() {
+	bitRows = arena.Allocate<uint64_t>(static_cast<size_t>(cityCount) * wordCount);
+	workRows = arena.Allocate<uint64_t>(static_cast<size_t>(cityCount) * wordCount);
+
+	for (size_t i = 0; i < static_cast<size_t>(cityCount) * wordCount; ++i) {
+		bitRows[i] = 0;
+		workRows[i] = 0;
+	}
+}
+
+inline const int* RuntimeGraph::ReadDistanceRow(int city, int* buffer) const {
+	if (distances != NULL)
+		return distances + static_cast<size_t>(city) * cityCount;
+
+	const uint16_t* row = sharedDistances + static_cast<size_t>(city) * cityCount;
+	for (int j = 0; j < cityCount; ++j)
+		buffer[j] = row[j];
+
+	return buffer;
+}
+
+inline void RuntimeGraph::FilterBand(int low, int high) {
+	BandFilterRowFunction filterRow = GetBandFilterRowFunction(GetBandFilterKernel());
+	std::vector<int> buffer(distances != NULL ? 0 : cityCount);
+
+	for (int i = 0; i < cityCount; ++i)
+		filterRow(ReadDistanceRow(i, buffer.data()), NULL, cityCount, low, high, bitRows + static_cast<size_t>(i) * wordCount);
+
+	ResetWorkRows();
+}
+
+inline void RuntimeGraph::SetBand(const uint64_t* words) {
+	for (size_t i = 0; i < static_cast<size_t>(cityCount) * wordCount; ++i)
+		bitRows[i] = words[i];
+
+	ResetWorkRows();
+}
+
+inline int RuntimeGraph::Degree(int city) const {
+	const uint64_t* row = BitRow(city);
+	int degree = 0;
+
+	for (int w = 0; w < wordCount; ++w)
+		degree += BitCount(row[w]);
+
+	return degree;
+}
+
+inline void RuntimeGraph::ResetWorkRows() {
+	for (size_t i = 0; i < static_cast<size_t>(cityCount) * wordCount; ++i)
+		workRows[i] = bitRows[i];
+}
+
+inline CityPath RuntimeGraph::CreatePath() {
+	int* storage = arena.Allocate<int>(cityCount);
+
+	if (storage == NULL)
+		return CityPath();
+
+	return CityPath(storage, cityCount);
+}
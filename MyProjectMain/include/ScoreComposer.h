@@ -0,0 +1,187 @@
+#pragma once
+
+#include <type_traits>
+#include <StaticVectorLibrary.h>
+#include <StaticBitsetLibrary.h>
+#include <BitAdjacency.h>
+#include <Algorithms.h>
+
+// One term of a composed score, the algorithm's score is multiplied by Numerator / Denominator.
+// The algorithm is one of the Algorithms classes, it is called directly instead of through the virtual table.
+template <class Algorithm, int Numerator, int Denominator = 1>
+struct WeightedTerm {
+	typedef Algorithm AlgorithmType;
+	static constexpr double WEIGHT = static_cast<double>(Numerator) / Denominator;
+};
+
+template <class Algorithm, int Numerator, int Denominator>
+constexpr double WeightedTerm<Algorithm, Numerator, Denominator>::WEIGHT;
+
+// Algorithms which have a Score overload on bit rows, the composer uses that overload when it has the bit rows
+template <class Algorithm>
+struct HasBitScore : std::false_type {};
+
+template <class T, unsigned int N>
+struct HasBitScore<FirstOrderNeighbors<T, N>> : std::true_type {};
+
+template <class T, unsigned int N>
+struct HasBitScore<SecondOrderNeighbors<T, N>> : std::true_type {};
+
+template <class T, unsigned int N>
+struct HasBitScore<ThirdOrderNeighbors<T, N>> : std::true_type {};
+
+// Algorithms which can be prepared from bit rows. The other terms keep no prepared state, Prepare of Algorithms does nothing for them.
+template <class Algorithm>
+struct HasBitPrepare : std::false_type {};
+
+template <class T, unsigned int N>
+struct HasBitPrepare<ClosenessCentrality<T, N>> : std::true_type {};
+
+template <class T, unsigned int N>
+struct HasBitPrepare<BetweennessCentrality<T, N>> : std::true_type {};
+
+// Recursive list of the terms of a ScoreComposer. Scores are added in the order of the terms,
+// the same order FindLongestPathCombination adds them, so both give the same results.
+template <class T, unsigned int N, class... Terms>
+class ScoreTerms;
+
+template <class T, unsigned int N>
+class ScoreTerms<T, N> {
+public:
+	static const int TERM_COUNT = 0;
+
+	void Prepare(StaticVector<StaticVector<T, N>, N>&) {}
+	void Prepare(const BitAdjacency<N>&) {}
+	void RemoveVertex(T) {}
+	void Accumulate(double&, T, StaticVector<StaticVector<T, N>, N>&, bool[N]) {}
+	void Accumulate(double&, T, StaticVector<StaticVector<T, N>, N>&, bool[N], const BitAdjacency<N>&, const StaticBitset<N>&) {}
+};
+
+template <class T, unsigned int N, class Term, class... Rest>
+class ScoreTerms<T, N, Term, Rest...> {
+public:
+	typedef typename Term::AlgorithmType TermAlgorithm;
+
+	static const int TERM_COUNT = 1 + sizeof...(Rest);
+
+	void Prepare(StaticVector<StaticVector<T, N>, N>& graph) {
+		algorithm.TermAlgorithm::Prepare(graph);
+		rest.Prepare(graph);
+	}
+
+	void Prepare(const BitAdjacency<N>& adjacency) {
+		TermPrepare(HasBitPrepare<TermAlgorithm>(), adjacency);
+		rest.Prepare(adjacency);
+	}
+
+	void RemoveVertex(T vertex) {
+		algorithm.TermAlgorithm::RemoveVertex(vertex);
+		rest.RemoveVertex(vertex);
+	}
+
+	void Accumulate(double& total, T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]) {
+		total += Term::WEIGHT * algorithm.TermAlgorithm::Score(node, graph, visited); // Qualified call, no virtual dispatch
+		rest.Accumulate(total, node, graph, visited);
+	}
+
+	void Accumulate(double& total, T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N],
+		const BitAdjacency<N>& adjacency, const StaticBitset<N>& visitedBits) {
+		total += Term::WEIGHT * TermScore(HasBitScore<TermAlgorithm>(), node, graph, visited, adjacency, visitedBits);
+		rest.Accumulate(total, node, graph, visited, adjacency, visitedBits);
+	}
+
+	// Algorithm of the first term and the remaining terms, for settings like SetThreadPool
+	TermAlgorithm& GetAlgorithm() { return algorithm; }
+	ScoreTerms<T, N, Rest...>& GetRest() { return rest; }
+
+private:
+	void TermPrepare(std::true_type, const BitAdjacency<N>& adjacency) {
+		algorithm.TermAlgorithm::Prepare(adjacency);
+	}
+
+	void TermPrepare(std::false_type, const BitAdjacency<N>&) {
+	}
+
+	double TermScore(std::true_type, T node, StaticVector<StaticVector<T, N>, N>&, bool[N],
+		const BitAdjacency<N>& adjacency, const StaticBitset<N>& visitedBits) {
+		return algorithm.TermAlgorithm::Score(node, adjacency, visitedBits);
+	}
+
+	double TermScore(std::false_type, T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N],
+		const BitAdjacency<N>&, const StaticBitset<N>&) {
+		return algorithm.TermAlgorithm::Score(node, graph, visited);
+	}
+
+	TermAlgorithm algorithm;
+	ScoreTerms<T, N, Rest...> rest;
+};
+
+// Weighted sum of the scores of the terms, the algorithms and weights are fixed at compile time so
+// the whole combination inlines into the neighbor loop. Prepare also builds bit rows of the graph
+// which are shared by every term that has a bit row Score, RemoveVertex keeps them in sync with the matrix.
+template <class T, unsigned int N, class... Terms>
+class ScoreComposer {
+public:
+	static const int TERM_COUNT = sizeof...(Terms);
+
+	ScoreComposer() : prepared(false) {}
+
+	// Same hooks as Algorithms, forwarded to every term
+	void Prepare(StaticVector<StaticVector<T, N>, N>& graph) {
+		adjacency.Build(graph);
+		prepared = true;
+		terms.Prepare(graph);
+	}
+
+	// Prepares from bit rows of a graph which is already filtered, the matrix of the graph isn't read.
+	// Matrix scores of the terms without a bit row Score are only valid if they are prepared too.
+	void Prepare(const BitAdjacency<N>& graph) {
+		adjacency = graph;
+		prepared = true;
+		terms.Prepare(adjacency);
+	}
+
+	void RemoveVertex(T vertex) {
+		if (prepared)
+			adjacency.RemoveVertex(vertex);
+		terms.RemoveVertex(vertex);
+	}
+
+	// Scores with the matrix for every term, works without Prepare
+	double Score(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]) {
+		double total = 0;
+		terms.Accumulate(total, node, graph, visited);
+		return total;
+	}
+
+	// Scores with the bit rows where a term supports them, visitedBits has to hold the same cities as visited.
+	// Only valid between Prepare and the next change of the graph which isn't reported with RemoveVertex.
+	double Score(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N], const StaticBitset<N>& visitedBits) {
+		double total = 0;
+		terms.Accumulate(total, node, graph, visited, adjacency, visitedBits);
+		return total;
+	}
+
+	bool IsPrepared() const { return prepared; }
+	const BitAdjacency<N>& GetAdjacency() const { return adjacency; }
+	ScoreTerms<T, N, Terms...>& GetTerms() { return terms; }
+
+private:
+	ScoreTerms<T, N, Terms...> terms;
+	BitAdjacency<N> adjacency;
+	bool prepared;
+};
+
+// Wraps a composer as an Algorithms so it can be used wherever the runtime interface is expected
+template <class T, unsigned int N, class Composer>
+class ComposedAlgorithm : public Algorithms<T, N> {
+public:
+	double Score(T node, StaticVector<StaticVector<T, N>, N>& graph, bool visited[N]) { return composer.Score(node, graph, visited); }
+	void Prepare(StaticVector<StaticVector<T, N>, N>& graph) { composer.Prepare(graph); }
+	void RemoveVertex(T vertex) { composer.RemoveVertex(vertex); }
+
+	Composer& GetComposer() { return composer; }
+
+private:
+	Composer composer;
+};
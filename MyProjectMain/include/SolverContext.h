@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <StaticVectorLibrary.h>
+#include <RandomGenerator.h>
+#include <ProblemConfig.h>
+
+// Everything a solver writes while it runs: found paths, visit counters, the random generator and scratch buffers.
+// Solvers take a context instead of using globals, so each thread can run solvers on its own context at the same time.
+template <unsigned int N>
+struct BasicSolverContext {
+	static const uint64_t DEFAULT_SEED = 5489;
+
+	StaticVector<int, N> foundPath;   // Path of the last search
+	StaticVector<int, N> longestPath; // Longest path LongestPath found between two cities
+	int cityTimes[N];                 // How many times LongestPath entered each city
+	RandomGenerator random;
+
+	// Copy of the graph for the searches that remove visited cities from it
+	StaticVector<StaticVector<int, N>, N> graph;
+	bool visited[N];
+
+	explicit BasicSolverContext(uint64_t seed = DEFAULT_SEED) : random(seed) {
+		Reset();
+	}
+
+	// Clears the paths, the counters and visited, the random generator continues its sequence
+	void Reset() {
+		foundPath = StaticVector<int, N>();
+		longestPath = StaticVector<int, N>();
+
+		for (int i = 0; i < N; ++i) {
+			cityTimes[i] = 0;
+			visited[i] = false;
+		}
+	}
+
+	// Resets the context and copies source to the scratch graph
+	void PrepareGraph(StaticVector<StaticVector<int, N>, N>& source) {
+		Reset();
+
+		for (int i = 0; i < N; ++i) {
+			for (int j = 0; j < N; ++j)
+				graph[i][j] = source[i][j];
+		}
+	}
+};
+
+typedef BasicSolverContext<CITY_COUNT> SolverContext;
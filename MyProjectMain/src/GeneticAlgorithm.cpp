@@ -1,14 +1,25 @@
 #pragma once
 
 #include <iostream>
+#include <iomanip>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <algorithm>
 #include <LinkedListLibrary.h>
 #include <StaticVectorLibrary.h>
+#include <BitAdjacency.h>
+#include <BandFilter.h>
+#include <ProblemConfig.h>
+#include <RandomGenerator.h>
+#include <Algorithms.h>
+#include <SolverContext.h>
+#include <GenePopulation.h>
+#include <LocalSearch.h>
+#include <IncrementalPath.h>
+#include <WorkStealingThreadPool.h>
 #include <time.h>
 
-#define CITY_COUNT 81 // 81
-#define START 5
-#define DISTANCE 250
-#define TOLERANCE 50
 #define POPULATION_SIZE 100 // ? 100
 
 
@@ -35,11 +46,12 @@ struct IndividualPath {
 // Function to return the fitness value of a gnome.
 // The fitness value is the path length
 // of the path represented by the GNOME.
+// band holds the city pairs in the distance band, built once with BuildBandAdjacency
 template <class T, unsigned int N>
-int CalculateFitness(StaticVector<T, N> gnome, StaticVector<StaticVector<T, N>, N>& adjMatrix) {
+int CalculateFitness(const T* gnome, int length, const BitAdjacency<N>& band) {
     int score = 0;
-    for (int i = 0; i < gnome.GetSize() - 1; i++) {
-        if (adjMatrix[gnome[i]][gnome[i+1]] <= DISTANCE + TOLERANCE && adjMatrix[gnome[i]][gnome[i + 1]]  >= DISTANCE - TOLERANCE)
+    for (int i = 0; i < length - 1; i++) {
+        if (band.HasEdge(gnome[i], gnome[i + 1]))
             score += 1;
         else
             return -1;
@@ -48,12 +60,12 @@ int CalculateFitness(StaticVector<T, N> gnome, StaticVector<StaticVector<T, N>,
 }
 
 // Function to return a random number from cities besides the starting point
-int RandNum() {
+int RandNum(RandomGenerator& random) {
     int num = CITY_COUNT;
     int rnum = 0;
 
     while (true) {
-        rnum = rand() % num;
+        rnum = random.NextInt(0, num);
         
         if (rnum != START)
             break;
@@ -62,176 +74,237 @@ int RandNum() {
     return rnum;
 }
 
-int RandNum(int start, int end)
+// Random number in [start, end) from the generator of the solver context
+int RandNum(RandomGenerator& random, int start, int end)
 {
-    int r = end - start;
-    int rnum = start + rand() % r;
-    return rnum;
+    return random.NextInt(start, end);
 }
 
-// Function to check if the character
-// has already occurred in the string
-template <typename T, unsigned int N>
-bool Repeat(StaticVector<T,N>& gnome, T temp) {
-
-    for (int i = 0; i < gnome.GetSize(); i++) {
-        if (gnome[i] == temp) // comparator gerekebilir
-            return true;
-    }
-    return false;
+// Random city which is not in the gnome, picked from the complement of its members
+// so no draw is rejected
+template <unsigned int N>
+int RandomUnvisitedCity(const StaticBitset<N>& members, RandomGenerator& random) {
+    StaticBitset<N> unvisited = ~members;
+    return unvisited.Select(RandNum(random, 0, unvisited.Count()));
 }
 
-template <class T, unsigned int N>
-int FindMostNeighborIndex(int startingIndex, StaticVector<T, N> tempGnome, StaticVector<StaticVector<T, N>, N>& adjMatrix) {
+// Band neighbor of startingIndex which is not in the gnome and has the most neighbors, -1 if there is none
+template <unsigned int N>
+int FindMostNeighborIndex(int startingIndex, const StaticBitset<N>& members, const BitAdjacency<N>& band) {
 
     int mostNeighbor = 0;
     int mostNeighborIndex = -1;
 
-    for (int i = 0; i < N; i++) {
-        
-        int temp = 0;
-        if (!Repeat(tempGnome, i) && adjMatrix[startingIndex][i] <= DISTANCE + TOLERANCE && adjMatrix[startingIndex][i] >= DISTANCE - TOLERANCE) {
-            for (int j = 0; j < N; j++) {
-                if (adjMatrix[i][j] <= DISTANCE + TOLERANCE && adjMatrix[i][j] >= DISTANCE - TOLERANCE)
-                    temp++;
-            }
-        }
+    StaticBitset<N> candidates = band.Row(startingIndex);
+    candidates.AndNot(members);
+
+    for (int i = candidates.FindFirst(); i != -1; i = candidates.FindNext(i)) {
+        int temp = band.Degree(i); // Neighbors of i in the band
 
         if (temp > mostNeighbor) {
             mostNeighbor = temp;
             mostNeighborIndex = i;
         }
-
     }
 
-
     return mostNeighborIndex;
 }
 
+// Writes a new gnome to tempGnome, which has room for N genes, and its cities to members. Returns its length.
 template <class T, unsigned int N>
-StaticVector<T, N> CreateGnome(StaticVector<StaticVector<T, N>, N>& adjMatrix) {
-    int gnomeSize = RandNum(2, N);
+int CreateGnome(const BitAdjacency<N>& band, RandomGenerator& random, T* tempGnome, StaticBitset<N>& members) {
+    int gnomeSize = RandNum(random, 2, N);
 
     // Creating gnome using the neighbor's neighbor method
     // Selecting the neighbor which has the most neighbors
-    StaticVector<T, N> tempGnome;
-    tempGnome.PushBack(START);
+    int length = 0;
+    members.Clear();
+    tempGnome[length++] = START;
+    members.Set(START);
 
     for (int i = 0; i < gnomeSize; i++) {
-        int mostNeighborIndex = FindMostNeighborIndex(tempGnome[i], tempGnome, adjMatrix);
+        int next = FindMostNeighborIndex(tempGnome[i], members, band);
 
-        if (mostNeighborIndex == -1) {
-            // add a random neighbor which is not in gnome
-            while (true) {
-
-                T randomElement = RandNum(0, N);
-                if (!Repeat(tempGnome, randomElement)) {
-                    tempGnome.PushBack(randomElement);
-                    break;
-                }
-            }
-
-        }
-        else
-            tempGnome.PushBack(mostNeighborIndex);
+        if (next == -1) // add a random city which is not in gnome
+            next = RandomUnvisitedCity(members, random);
 
+        tempGnome[length++] = next;
+        members.Set(next);
     }
 
-    return tempGnome;
+    return length;
 }
 
-// Function to return a mutated GNOME
-// with a random interchange
-// of two genes to create variation in species
-template <class T, unsigned int N>
-StaticVector<T, N> MutatedGene(StaticVector<T, N> gnome)
+// Picks the two positions a mutation swaps
+// If gnome is empty, gnome size with 1 or 2 doesn't change anything "", "0", "0->2" doesn't changes
+bool PickMutatedGenes(int length, RandomGenerator& random, int& r, int& r1)
 {
-    if (gnome.GetSize() <= 2) // If gnome is empty, gnome size with 1 or 2 doesn't change anything "", "0", "0->2" doesn't changes
-        return gnome;
+    if (length <= 2)
+        return false;
 
     while (true) {
-        int r = RandNum(1, gnome.GetSize()); // Don't change the starting vertex
-        int r1 = RandNum(1, gnome.GetSize());
+        r = RandNum(random, 1, length); // Don't change the starting vertex
+        r1 = RandNum(random, 1, length);
 
-        if (r1 != r && r1 != START && r != START) {
-            T temp = gnome[r];
-            gnome[r] = gnome[r1];
-            gnome[r1] = temp;
-            break;
-        }
+        if (r1 != r && r1 != START && r != START)
+            return true;
     }
-    return gnome;
 }
 
+// Function to mutate a GNOME in place
+// with a random interchange
+// of two genes to create variation in species
 template <class T>
-T RandomGene() {
-    return RandNum(0, CITY_COUNT);
+void MutatedGene(T* gnome, int length, RandomGenerator& random)
+{
+    int r = 0;
+    int r1 = 0;
+
+    if (PickMutatedGenes(length, random, r, r1)) {
+        T temp = gnome[r];
+        gnome[r] = gnome[r1];
+        gnome[r1] = temp;
+    }
+}
+
+// Same mutation on a path with cached pair validity, only the pairs next to the two genes are checked again
+template <class T, unsigned int N>
+void MutatedGene(IncrementalPath<T, N>& path, RandomGenerator& random)
+{
+    int r = 0;
+    int r1 = 0;
+
+    if (PickMutatedGenes(path.GetLength(), random, r, r1))
+        path.Swap(r, r1);
 }
 
-// Mating two parents with each other according to probabilities
+// Mating two parents with each other according to probabilities, the child is written to childGnome
+// which has room for N genes and must not be one of the parents, and its cities to childMembers.
+// Returns the length of the child.
 template <class T, unsigned int N>
-StaticVector<T, N> Mate(IndividualPath<T, N> parent1, IndividualPath<T, N> parent2) {
+int Mate(const T* parent1, int length1, const T* parent2, int length2, RandomGenerator& random,
+    T* childGnome, StaticBitset<N>& childMembers) {
 
-    StaticVector<T, N> childGnome;
-    int childGnomeSize = (parent1.gnome.GetSize() + parent2.gnome.GetSize()) / 2; // Getting mean of parent1 and parent2 sizes
+    int childGnomeSize = (length1 + length2) / 2; // Getting mean of parent1 and parent2 sizes
     int i = 0;
     float p = 0;
-    childGnome.PushBack(parent1.gnome[0]); // Start should be same for all offsprings
-    i++;
+    childMembers.Clear();
+    childGnome[i++] = parent1[0]; // Start should be same for all offsprings
+    childMembers.Set(parent1[0]);
+
     while(i < childGnomeSize) {
         
-        p = float(RandNum(0, 100)) / 100;
-        T temp;
+        p = float(RandNum(random, 0, 100)) / 100;
+        int temp = -1;
         // if prob is less than 0.45, insert gene
         // from parent 1 
-        if (p < 0.45) {
-
-            if (parent1.gnome.GetSize() <= i) {
-                temp = RandomGene<T>();
-                if (!Repeat(childGnome, temp)) {
-                    childGnome.PushBack(temp);
-                    i++;
-                }
-            }
-            else {
-                
-                temp = parent1.gnome[i];
-                if (!Repeat(childGnome, temp)) {
-                    childGnome.PushBack(temp);
-                    i++;
-                }
-            }
-        }
+        if (p < 0.45 && i < length1)
+            temp = parent1[i];
         // if prob is between 0.45 and 0.90, insert
         // gene from parent 2
-        else if (p < 0.90) {
-            if (parent2.gnome.GetSize() <= i) {
-                temp = RandomGene<T>();
-                if (!Repeat(childGnome, temp)) {
-                    childGnome.PushBack(temp);
-                    i++;
-                }
-            }
-            else {
-                temp = parent2.gnome[i];
-                if (!Repeat(childGnome, temp)) {
-                    childGnome.PushBack(temp);
-                    i++;
-                }
+        else if (p >= 0.45 && p < 0.90 && i < length2)
+            temp = parent2[i];
+
+        // otherwise insert random gene(mutate), 
+        // for maintaining diversity. A parent gene already in the child is drawn again.
+        if (temp == -1)
+            temp = RandomUnvisitedCity(childMembers, random);
+        else if (childMembers.Test(temp))
+            continue;
+
+        childGnome[i++] = temp;
+        childMembers.Set(temp);
+    }
+
+    return i;
+}
+
+// Adds the pairs of consecutive genes which are band edges to edges
+template <class T, unsigned int N>
+void AddParentEdges(const T* parent, int length, const BitAdjacency<N>& band, BitAdjacency<N>& edges) {
+    for (int i = 0; i < length - 1; i++) {
+        if (band.HasEdge(parent[i], parent[i + 1]))
+            edges.AddEdge(parent[i], parent[i + 1]);
+    }
+}
+
+// Edge recombination restricted to the band. edges is scratch space for the edge map, it gets the band edges
+// next to every city in either parent. The child starts like parent1 and always moves along an edge of the map
+// to the city with the fewest edges left, ties are broken at random. It stops when the last city has no edge
+// left, so the child is always a valid path. Returns the length of the child.
+template <class T, unsigned int N>
+int EdgeRecombination(const T* parent1, int length1, const T* parent2, int length2, const BitAdjacency<N>& band,
+    RandomGenerator& random, BitAdjacency<N>& edges, T* childGnome, StaticBitset<N>& childMembers) {
+
+    edges.Clear();
+    AddParentEdges(parent1, length1, band, edges);
+    AddParentEdges(parent2, length2, band, edges);
+
+    int length = 0;
+    int current = parent1[0];
+    childMembers.Clear();
+
+    while (current != -1) {
+        childGnome[length++] = current;
+        childMembers.Set(current);
+
+        StaticBitset<N> candidates = edges.Row(current);
+        candidates.AndNot(childMembers);
+
+        int next = -1;
+        int fewestEdges = N + 1;
+        int ties = 0;
+        for (int city = candidates.FindFirst(); city != -1; city = candidates.FindNext(city)) {
+            int edgesLeft = edges.UnvisitedDegree(city, childMembers);
+
+            if (edgesLeft < fewestEdges) {
+                fewestEdges = edgesLeft;
+                next = city;
+                ties = 1;
             }
+            else if (edgesLeft == fewestEdges && RandNum(random, 0, ++ties) == 0)
+                next = city;
         }
-        else {
-            temp = RandomGene<T>();
-            if (!Repeat(childGnome, temp)) {
-                childGnome.PushBack(temp);
-                i++;
+
+        current = next;
+    }
+
+    return length;
+}
+
+// Cuts the gnome after its first validLength genes, which have to be a valid path, then appends the unvisited
+// band neighbor of the last city with the highest FirstOrderNeighbors score until there is none. The gnome
+// becomes a valid path, members is kept in step. Returns the new length.
+template <class T, unsigned int N>
+int RepairGnome(T* gnome, int length, int validLength, StaticBitset<N>& members, const BitAdjacency<N>& band) {
+    FirstOrderNeighbors<T, N> scorer;
+
+    for (int i = validLength; i < length; i++)
+        members.Reset(gnome[i]);
+    length = validLength;
+
+    while (length < static_cast<int>(N)) {
+        StaticBitset<N> candidates = band.Row(gnome[length - 1]);
+        candidates.AndNot(members);
+
+        int next = candidates.FindFirst();
+        if (next == -1)
+            break;
+
+        double highestScore = scorer.Score(next, band, members);
+        for (int city = candidates.FindNext(next); city != -1; city = candidates.FindNext(city)) {
+            double tempScore = scorer.Score(city, band, members);
+            if (tempScore > highestScore) {
+                highestScore = tempScore;
+                next = city;
             }
         }
-        // otherwise insert random gene(mutate), 
-        // for maintaining diversity
+
+        gnome[length++] = next;
+        members.Set(next);
     }
 
-    return childGnome;
+    return length;
 }
 
 // Function to return the updated value
@@ -240,159 +313,480 @@ int Cooldown(int temp) {
     return (90 * temp) / 100;
 }
 
-template< class T, unsigned int N>
-bool ComparePathsByFitnessScore(const IndividualPath<T,N>& path1, const IndividualPath<T,N>& path2) {
-    return path1.fitnessScore < path2.fitnessScore;
+// Keeps candidate in best when it is fitter, the first one found wins ties
+template <class T, unsigned int N>
+void KeepFittest(IndividualPath<T, N>& best, const IndividualPath<T, N>& candidate) {
+    if (candidate.fitnessScore > best.fitnessScore)
+        best = candidate;
 }
 
+// Copies a gnome of a population out to path
 template <class T, unsigned int N>
-StaticVector<T, N> GeneticAlgorithm(StaticVector<StaticVector<T, N>, N>& adjMatrix) {
+void CopyGnome(IndividualPath<T, N>& path, const T* gnome, int length, int fitnessScore) {
+    path.gnome = StaticVector<T, N>();
+    for (int i = 0; i < length; i++)
+        path.gnome.PushBack(gnome[i]);
+    path.fitnessScore = fitnessScore;
+}
+
+// Same for a gnome of a population, the genes are only copied when they are fitter
+template <class T, unsigned int N>
+void KeepFittest(IndividualPath<T, N>& best, const T* gnome, int length, int fitnessScore) {
+    if (fitnessScore > best.fitnessScore)
+        CopyGnome(best, gnome, length, fitnessScore);
+}
+
+// Returns the fittest individual of every population the algorithm created
+template <class T, unsigned int N>
+IndividualPath<T, N> GeneticAlgorithm(StaticVector<StaticVector<T, N>, N>& adjMatrix, BasicSolverContext<N>& context) {
 
     // Generation Number
     int gen = 1;
     // Number of Gene Iterations
     int genThreshold = 500;
     
-    srand(time(NULL));
+    RandomGenerator& random = context.random;
+
+    // Pairs in the distance band, every fitness and neighbor test reads these bits
+    BitAdjacency<N> band;
+    BuildBandAdjacency(adjMatrix, band, DISTANCE - TOLERANCE, DISTANCE + TOLERANCE);
 
-    StaticVector<struct IndividualPath<T, N>, POPULATION_SIZE> population;
-    struct IndividualPath<T, N> tempPath;
-    StaticVector<T, N> tempGnome;
+    GenePopulation<T, N> population(POPULATION_SIZE);
+    struct IndividualPath<T, N> best;
+    best.fitnessScore = -1;
 
     std::cout << "Printing the gnomes and their fitness scores" << std::endl;
     std::cout << "Creating random gnomes for population" << std::endl;
     // Populating the GNOME pool.
     
     for (int i = 0; i < POPULATION_SIZE; i++) {
-        //struct IndividualPath<T, N> tempPath;
-        //StaticVector<T, N> tempGnome;
-        tempGnome = CreateGnome<T, N>(adjMatrix);
-        tempPath.gnome = tempGnome;
+        T* gnome = population.Genes(i);
+        population.Length(i) = CreateGnome<T, N>(band, random, gnome, population.Members(i));
         //cout << "Gnome is: " << endl;
-        //tempPath.gnome.PrintData();
-        tempPath.fitnessScore = CalculateFitness(tempPath.gnome, adjMatrix);
-        //cout << "Fitness score is: " << tempPath.fitnessScore << endl;
-        population.PushBack(tempPath);
+        population.Fitness(i) = CalculateFitness(gnome, population.Length(i), band);
+        //cout << "Fitness score is: " << population.Fitness(i) << endl;
+        KeepFittest(best, gnome, population.Length(i), population.Fitness(i));
     }
+    population.SetSize(POPULATION_SIZE);
 
     
     std::cout << "\nInitial population: " << std::endl
         << "GNOME     FITNESS VALUE\n";
     for (int i = 0; i < POPULATION_SIZE; i++) {
         std::cout << "Gnome is: " << std::endl;
-        //std::cout << population[i].gnome;
-        std::cout << "Fitness score is: " << population[i].fitnessScore << std::endl;
+        std::cout << "Fitness score is: " << population.Fitness(i) << std::endl;
     }
     
     
-    bool found = false;
     int temperature = 300000; // ???
 
     // Iteration to perform
     // population crossing and gene mutation.
     while (temperature > 1000 && gen <= genThreshold) {
-        population.Sort(ComparePathsByFitnessScore); // Sort population with fitness scores
-        StaticVector<struct IndividualPath<T, N>, POPULATION_SIZE> newPopulation;
-
-        //cout << "Starting to mutate genes" << endl;
-        /*
-        for (int i = 0; i < POPULATION_SIZE; i++) {
-            struct IndividualPath<T, N> p1 = population.GetIndex(i);
-
-            while (true) {
-                StaticVector<T, N> newGnome = MutatedGene<T, N>(p1.gnome);
-                struct IndividualPath<T, N> newPath; ///////////////////////////////////
-                newPath.gnome = newGnome;
-                newPath.fitnessScore = CalculateFitness<T, N>(newPath.gnome, adjMatrix);
-
-                
-                if (newPath.fitnessScore >= population.GetIndex(i).fitnessScore) {
-                    newPopulation.PushBack(newPath);
-                    break;
-                }
-                else {
-
-                    // Accepting the rejected children at
-                    // a possible probability above threshold.
-                    float prob = pow(2.7,
-                        -1 * ((float)(newPath.fitnessScore
-                            - population.GetIndex(i).fitnessScore)
-                            / temperature));
-                    if (prob > 0.5) {
-                        newPopulation.PushBack(newPath);
-                        break;
-                    }
-                }
-            }
-        }
-        */
-        
         //cout << "Starting to crossover" << endl;
 
         for (int i = 0; i < POPULATION_SIZE; i++)
         {
-            int r = RandNum(0, POPULATION_SIZE);
-            IndividualPath<T, N> parent1 = population[r];
-            r = RandNum(0, POPULATION_SIZE);
-            IndividualPath<T, N> parent2 = population[r];
-            StaticVector<T, N> newGnome = Mate(parent1, parent2);
-
-            struct IndividualPath<T, N> offspring;
-            offspring.gnome = newGnome;
+            // Parents are picked uniformly, the population doesn't need to be sorted for that
+            int parent1 = RandNum(random, 0, POPULATION_SIZE);
+            int parent2 = RandNum(random, 0, POPULATION_SIZE);
+
+            // The offspring is written to the next generation buffer
+            T* offspring = population.NextGenes(i);
+            int length = Mate(population.Genes(parent1), population.Length(parent1),
+                population.Genes(parent2), population.Length(parent2), random, offspring, population.NextMembers(i));
             //cout << "Calculating fitness score" << endl;
-            offspring.fitnessScore = CalculateFitness<T, N>(offspring.gnome, adjMatrix);
+            population.NextLength(i) = length;
+            population.NextFitness(i) = CalculateFitness(offspring, length, band);
 
-            newPopulation.PushBack(offspring);
+            KeepFittest(best, offspring, length, population.NextFitness(i));
         }
 
 
         //temperature = Cooldown(temperature);
-        //population = newPopulation;
+        population.Swap(POPULATION_SIZE);
         //cout << "Generation " << gen << " \n";
-        //cout << "GNOME     FITNESS VALUE\n";
-
-        for (int i = 0; i < POPULATION_SIZE; i++) {
-            //cout << "Gnome is: ";
-            //newPopulation.GetIndex(i).gnome.PrintData();
-            //cout << " Fitness score is: " << newPopulation.GetIndex(i).fitnessScore << endl;
-        }
         gen++;
 
         if (!(gen <= genThreshold)) {
             //cout << "--------------------" << endl;
             //cout << "Found the best one " << endl;
             //cout << "--------------------" << endl;
+            std::cout << best.gnome;
+            std::cout << "Best of the best" << std::endl;
+            std::cout << " Fitness score is: " << best.fitnessScore << std::endl;
+        }
+    }
+    
+    return best;
+
+}
+
+enum GeneticCrossover {
+    CROSSOVER_UNIFORM,            // Mate, genes picked position by position from the parents
+    CROSSOVER_EDGE_RECOMBINATION  // EdgeRecombination, only band edges of the parents
+};
+
+enum GeneticSelection {
+    SELECTION_UNIFORM,    // Any individual
+    SELECTION_TOURNAMENT, // Fittest of tournamentSize random individuals
+    SELECTION_ROULETTE    // Chance proportional to fitness + 1, invalid gnomes are never picked
+};
+
+struct GeneticAlgorithmConfig {
+    int islandCount = 4;
+    int populationSize = POPULATION_SIZE; // Per island
+    int generations = 500;
+    int migrationInterval = 25;           // Generations between migrations
+    int migrantCount = 2;                 // Fittest individuals sent to the next island
+    double mutationRate = 0.1;            // Probability of MutatedGene on a child
+    int crossover = CROSSOVER_EDGE_RECOMBINATION;
+    bool repair = true;                   // RepairGnome on every child, children are always valid paths
+    int selection = SELECTION_ROULETTE;
+    int tournamentSize = 3;
+    int eliteCount = 1;                   // Fittest individuals copied to the next generation
+    bool improveElites = true;            // Runs eliteSearch on every elite before it is copied
+    LocalSearchConfig eliteSearch;
+    uint64_t seed = 5489;
+};
+
+// Fitness of one generation, found in one pass over the population
+struct GenerationStats {
+    int best = -1;
+    int worst = -1;
+    double mean = 0;
+    int validCount = 0; // Individuals with a fitness of 0 or more
+};
+
+template <class T, unsigned int N>
+GenerationStats ComputeGenerationStats(const GenePopulation<T, N>& population) {
+    GenerationStats stats;
+    if (population.GetSize() == 0)
+        return stats;
+
+    stats.best = stats.worst = population.Fitness(0);
+    long long sum = 0;
+
+    for (int i = 0; i < population.GetSize(); ++i) {
+        int fitness = population.Fitness(i);
+        stats.best = std::max(stats.best, fitness);
+        stats.worst = std::min(stats.worst, fitness);
+        sum += fitness;
+        if (fitness >= 0)
+            stats.validCount++;
+    }
+
+    stats.mean = static_cast<double>(sum) / population.GetSize();
+    return stats;
+}
+
+template <class T, unsigned int N>
+struct GeneticAlgorithmResult {
+    IndividualPath<T, N> best;
+    int bestIsland = -1;
+    int generations = 0;
+    int migrations = 0;
+    double milliseconds = 0;
+    std::vector<int> islandBestFitness;
+    std::vector<GenerationStats> generationStats; // Over all islands, index 0 is the first population
+};
+
+// Sub-population evolved by one task, the generator is the island's own so islands never share random state
+template <class T, unsigned int N>
+struct GeneticIsland {
+    GenePopulation<T, N> population;
+    IndividualPath<T, N> best;
+    RandomGenerator random;
+    BitAdjacency<N> edges; // Edge map of EdgeRecombination
+    std::vector<int> indices;     // Scratch for elite selection
+    std::vector<double> roulette; // Cumulative weights of roulette selection
+    std::vector<GenerationStats> history;
+    LocalSearch<T, N> localSearch;
+    IncrementalPath<T, N> path; // Child being mutated
+    long long evaluations; // Gnomes made plus local search moves tried, for convergence against work done
+
+    explicit GeneticIsland(int populationSize) : population(populationSize), evaluations(0) {
+    }
+};
+
+// First generation of an island from CreateGnome
+template <class T, unsigned int N>
+void InitializeIsland(GeneticIsland<T, N>& island, const BitAdjacency<N>& band, const GeneticAlgorithmConfig& config) {
+    GenePopulation<T, N>& population = island.population;
+
+    for (int i = 0; i < config.populationSize; ++i) {
+        population.Length(i) = CreateGnome<T, N>(band, island.random, population.Genes(i), population.Members(i));
+        population.Fitness(i) = CalculateFitness(population.Genes(i), population.Length(i), band);
+        KeepFittest(island.best, population.Genes(i), population.Length(i), population.Fitness(i));
+    }
+    population.SetSize(config.populationSize);
+    island.evaluations += config.populationSize;
 
-            newPopulation.Sort(ComparePathsByFitnessScore);
+    island.history.reserve(config.generations + 1);
+    island.history.push_back(ComputeGenerationStats(population));
+}
+
+// Puts the count fittest individuals, or the count least fit ones, first in indices. nth_element only
+// partitions, the rest of the population is not sorted. Ties go to the lower index.
+template <class T, unsigned int N>
+void PartitionByFitness(const GenePopulation<T, N>& population, std::vector<int>& indices, int count, bool fittest) {
+    indices.resize(population.GetSize());
+    for (int i = 0; i < population.GetSize(); ++i)
+        indices[i] = i;
+
+    if (count <= 0 || count >= population.GetSize())
+        return;
+
+    std::nth_element(indices.begin(), indices.begin() + count, indices.end(), [&](int lhs, int rhs) {
+        int lhsFitness = fittest ? population.Fitness(lhs) : -population.Fitness(lhs);
+        int rhsFitness = fittest ? population.Fitness(rhs) : -population.Fitness(rhs);
+        return lhsFitness > rhsFitness || (lhsFitness == rhsFitness && lhs < rhs);
+    });
+}
+
+// Running sums of fitness + 1 for roulette selection, built once per generation
+template <class T, unsigned int N>
+void PrepareRoulette(const GenePopulation<T, N>& population, std::vector<double>& cumulative) {
+    cumulative.resize(population.GetSize());
+    double total = 0;
 
-            //for (int i = 0; i < POPULATION_SIZE; i++) {
-               // cout << "Gnome is: ";
-                std::cout << newPopulation[0].gnome;
-                std::cout << "Best of the best" << std::endl;
-                std::cout << " Fitness score is: " << newPopulation[0].gnome.GetSize() << std::endl;
-            //}
+    for (int i = 0; i < population.GetSize(); ++i) {
+        total += population.Fitness(i) + 1;
+        cumulative[i] = total;
+    }
+}
+
+// Index of a parent picked by the configured selection, roulette needs PrepareRoulette first
+template <class T, unsigned int N>
+int SelectParent(const GenePopulation<T, N>& population, const GeneticAlgorithmConfig& config,
+    const std::vector<double>& cumulative, RandomGenerator& random) {
+
+    switch (config.selection) {
+    case SELECTION_TOURNAMENT: {
+        int winner = RandNum(random, 0, population.GetSize());
+        for (int i = 1; i < config.tournamentSize; ++i) {
+            int challenger = RandNum(random, 0, population.GetSize());
+            if (population.Fitness(challenger) > population.Fitness(winner))
+                winner = challenger;
         }
+        return winner;
     }
-    
-    return NULL;
+    case SELECTION_ROULETTE:
+        if (cumulative.back() > 0) {
+            double spin = random.NextDouble() * cumulative.back();
+            return static_cast<int>(std::upper_bound(cumulative.begin(), cumulative.end(), spin) - cumulative.begin());
+        }
+        return RandNum(random, 0, population.GetSize()); // Every gnome is invalid
+    default:
+        return RandNum(random, 0, population.GetSize());
+    }
+}
+
+// One generation of an island, the elites are kept and improved by local search, the rest are children of
+// selected parents made by the configured crossover. Children are written straight into the next generation buffer.
+template <class T, unsigned int N>
+void EvolveIsland(GeneticIsland<T, N>& island, const BitAdjacency<N>& band, const GeneticAlgorithmConfig& config) {
+    GenePopulation<T, N>& population = island.population;
+    int size = 0;
+
+    int eliteCount = std::min(config.eliteCount, population.GetSize());
+    if (eliteCount > 0) {
+        PartitionByFitness(population, island.indices, eliteCount, true);
+        for (; size < eliteCount; ++size) {
+            population.CopyToNext(island.indices[size], size);
+            if (!config.improveElites)
+                continue;
+
+            LocalSearchResult improved = island.localSearch.Run(band, config.eliteSearch, population.NextGenes(size),
+                population.NextLength(size), population.NextMembers(size), island.random);
+            population.NextFitness(size) = improved.bestFitness;
+            island.evaluations += improved.iterations;
+            KeepFittest(island.best, population.NextGenes(size), population.NextLength(size), improved.bestFitness);
+        }
+    }
+
+    if (config.selection == SELECTION_ROULETTE)
+        PrepareRoulette(population, island.roulette);
 
+    while (size < config.populationSize) {
+        int parent1 = SelectParent(population, config, island.roulette, island.random);
+        int parent2 = SelectParent(population, config, island.roulette, island.random);
+
+        T* offspring = population.NextGenes(size);
+        StaticBitset<N>& members = population.NextMembers(size);
+        int length = 0;
+        if (config.crossover == CROSSOVER_EDGE_RECOMBINATION)
+            length = EdgeRecombination(population.Genes(parent1), population.Length(parent1), population.Genes(parent2),
+                population.Length(parent2), band, island.random, island.edges, offspring, members);
+        else
+            length = Mate(population.Genes(parent1), population.Length(parent1),
+                population.Genes(parent2), population.Length(parent2), island.random, offspring, members);
+
+        // Pair validity is checked once here, the mutation and the repair cut only read the cache
+        IncrementalPath<T, N>& path = island.path;
+        path.Attach(band, offspring, length);
+        if (island.random.NextDouble() < config.mutationRate)
+            MutatedGene(path, island.random);
+
+        int fitness = path.GetFitness();
+        if (config.repair) {
+            length = RepairGnome(offspring, length, path.GetValidPrefixLength(), members, band);
+            fitness = length - 1;
+        }
+
+        population.NextLength(size) = length;
+        population.NextFitness(size) = fitness;
+        KeepFittest(island.best, offspring, length, fitness);
+        island.evaluations++;
+        size++;
+    }
+
+    population.Swap(size);
+    island.history.push_back(ComputeGenerationStats(population));
+}
+
+// Ring migration, the fittest individuals of every island replace the least fit ones of the next island.
+// Migrants are copied out first so an island sends what it had before receiving.
+template <class T, unsigned int N>
+void MigrateIslands(std::vector<std::unique_ptr<GeneticIsland<T, N>>>& islands, int migrantCount) {
+    int islandCount = static_cast<int>(islands.size());
+    std::vector<std::vector<IndividualPath<T, N>>> migrants(islandCount);
+
+    for (int i = 0; i < islandCount; ++i) {
+        GeneticIsland<T, N>& island = *islands[i];
+        int count = std::min(migrantCount, island.population.GetSize());
+        PartitionByFitness(island.population, island.indices, count, true);
+
+        migrants[i].resize(count);
+        for (int j = 0; j < count; ++j) {
+            int individual = island.indices[j];
+            CopyGnome(migrants[i][j], island.population.Genes(individual), island.population.Length(individual), island.population.Fitness(individual));
+        }
+    }
+
+    for (int i = 0; i < islandCount; ++i) {
+        GeneticIsland<T, N>& target = *islands[(i + 1) % islandCount];
+        int count = std::min(static_cast<int>(migrants[i].size()), target.population.GetSize());
+        PartitionByFitness(target.population, target.indices, count, false);
+
+        for (int j = 0; j < count; ++j) {
+            IndividualPath<T, N>& migrant = migrants[i][j];
+            target.population.Store(target.indices[j], &migrant.gnome[0], migrant.gnome.GetSize(), migrant.fitnessScore);
+            KeepFittest(target.best, migrant);
+        }
+    }
+}
+
+// Island model genetic algorithm. Every island is a task on the pool and evolves migrationInterval generations
+// on its own, then the islands swap migrants on the calling thread. Island i uses the generator of config.seed
+// jumped i times, so the result only depends on the config and not on the thread count.
+template <class T, unsigned int N>
+GeneticAlgorithmResult<T, N> IslandGeneticAlgorithm(StaticVector<StaticVector<T, N>, N>& adjMatrix, WorkStealingThreadPool& pool,
+    const GeneticAlgorithmConfig& config = GeneticAlgorithmConfig()) {
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    GeneticAlgorithmResult<T, N> result;
+
+    std::unique_ptr<BitAdjacency<N>> band(new BitAdjacency<N>());
+    BuildBandAdjacency(adjMatrix, *band, DISTANCE - TOLERANCE, DISTANCE + TOLERANCE);
+
+    std::vector<std::unique_ptr<GeneticIsland<T, N>>> islands;
+    RandomGenerator seedGenerator(config.seed);
+    for (int i = 0; i < config.islandCount; ++i) {
+        islands.emplace_back(new GeneticIsland<T, N>(config.populationSize));
+        islands[i]->random = seedGenerator;
+        islands[i]->best.fitnessScore = -1;
+        seedGenerator.Jump();
+    }
+
+    pool.ParallelFor(config.islandCount, [&](int islandIndex, int) {
+        InitializeIsland(*islands[islandIndex], *band, config);
+    });
+
+    while (result.generations < config.generations) {
+        int epoch = std::min(config.migrationInterval, config.generations - result.generations);
+
+        pool.ParallelFor(config.islandCount, [&](int islandIndex, int) {
+            for (int generation = 0; generation < epoch; ++generation)
+                EvolveIsland(*islands[islandIndex], *band, config);
+        });
+
+        result.generations += epoch;
+
+        if (result.generations < config.generations && config.islandCount > 1) {
+            MigrateIslands(islands, config.migrantCount);
+            result.migrations++;
+        }
+    }
+
+    result.best.fitnessScore = -1;
+    for (int i = 0; i < config.islandCount; ++i) {
+        result.islandBestFitness.push_back(islands[i]->best.fitnessScore);
+
+        if (islands[i]->best.fitnessScore > result.best.fitnessScore) {
+            result.best = islands[i]->best;
+            result.bestIsland = i;
+        }
+    }
+
+    // Generation statistics over all islands, the populations have the same size so the mean is the mean of means
+    if (!islands.empty())
+        result.generationStats = islands[0]->history;
+    for (int i = 1; i < config.islandCount; ++i) {
+        for (size_t generation = 0; generation < result.generationStats.size(); ++generation) {
+            GenerationStats& stats = result.generationStats[generation];
+            const GenerationStats& islandStats = islands[i]->history[generation];
+
+            stats.best = std::max(stats.best, islandStats.best);
+            stats.worst = std::min(stats.worst, islandStats.worst);
+            stats.mean += islandStats.mean;
+            stats.validCount += islandStats.validCount;
+        }
+    }
+    for (size_t generation = 0; generation < result.generationStats.size(); ++generation)
+        result.generationStats[generation].mean /= config.islandCount;
+
+    result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+// Prints the statistics of every interval generations and of the last one
+inline void PrintGenerationStats(const std::vector<GenerationStats>& generationStats, int interval) {
+    std::ios::fmtflags flags = std::cout.flags();
+    std::streamsize precision = std::cout.precision();
+
+    std::cout << std::setw(12) << "Generation" << std::setw(8) << "Best" << std::setw(8) << "Worst"
+        << std::setw(10) << "Mean" << std::setw(8) << "Valid" << std::endl;
+
+    for (size_t generation = 0; generation < generationStats.size(); ++generation) {
+        if (generation % interval != 0 && generation + 1 != generationStats.size())
+            continue;
+
+        const GenerationStats& stats = generationStats[generation];
+        std::cout << std::setw(12) << generation << std::setw(8) << stats.best << std::setw(8) << stats.worst
+            << std::setw(10) << std::fixed << std::setprecision(2) << stats.mean << std::setw(8) << stats.validCount << std::endl;
+    }
+
+    std::cout.flags(flags);
+    std::cout.precision(precision);
 }
 
 template< class T, unsigned int N>
 int GeneticAlgorithmUtil(StaticVector<StaticVector<T, N>, N>& adjMatrix) {
 
+    // Seeded from the clock like the previous srand(time(NULL)), the context keeps the generator of this run
+    std::unique_ptr<BasicSolverContext<N>> context(new BasicSolverContext<N>(static_cast<uint64_t>(time(NULL))));
+
     // Call the genetic algorithm
-    //StaticVector<T, N> bestSolution = GeneticAlgorithm<T, N>(adjMatrix);
     //for(int i = 0; i < 10; i++)
-        GeneticAlgorithm<T, N>(adjMatrix);
+        IndividualPath<T, N> bestSolution = GeneticAlgorithm<T, N>(adjMatrix, *context);
 
     // Print the best solution
-    /*
-    cout << "Best solution:";
-    for (int i = 0; i < N; i++) {
-        cout << " " << bestSolution.GetIndex(i);
+    std::cout << "Best solution:";
+    for (int i = 0; i < bestSolution.gnome.GetSize(); i++) {
+        std::cout << " " << bestSolution.gnome[i];
     }
-    cout << endl;
-    */
+    std::cout << std::endl;
+
     return 0;
 }
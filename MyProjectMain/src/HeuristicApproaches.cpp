@@ -1,118 +1,196 @@
 #pragma once
 
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <Algorithms.h>
-#include <LinkedListLibrary.h>
+#include <BitAdjacency.h>
+#include <BandFilter.h>
+#include <ScoreComposer.h>
+#include <StaticRingQueue.h>
 #include <StaticVectorLibrary.h>
+#include <ProblemConfig.h>
+#include <SolverContext.h>
+#include <IterativeDfs.h>
+
+
+// Weights of first order, second order, third order neighbors and closeness centrality in the combination
+const double COMBINATION_WEIGHTS[4] = { -1, 1, 1, 1 };
+
+// Same combination composed at compile time, used by FindLongestPathComposed
+template <unsigned int N>
+using BasicCombinationScorer = ScoreComposer<int, N,
+	WeightedTerm<FirstOrderNeighbors<int, N>, -1>,
+	WeightedTerm<SecondOrderNeighbors<int, N>, 1>,
+	WeightedTerm<ThirdOrderNeighbors<int, N>, 1>,
+	WeightedTerm<ClosenessCentrality<int, N>, 1>>;
+
+typedef BasicCombinationScorer<CITY_COUNT> CombinationScorer;
+
+// Band neighbors of a distance matrix in index order, the condition of the matrix DFS
+struct MatrixBandNeighbors {
+	StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>* adjMatrix;
+
+	// First unvisited neighbor after last, visited changes while traversing so it is checked on every call
+	int Next(int vertex, int last, const bool* visited) const {
+		for (int neighbor = last + 1; neighbor < CITY_COUNT; ++neighbor) {
+			int distance = (*adjMatrix)[vertex][neighbor];
+			if (distance >= (DISTANCE - TOLERANCE) && distance <= (DISTANCE + TOLERANCE) && !visited[neighbor])
+				return neighbor;
+		}
+		return -1;
+	}
+};
 
-#define CITY_COUNT 81
-#define DISTANCE 200
-#define TOLERANCE 50
+// Neighbors taken from the set bits of the row
+struct BitNeighbors {
+	const BitAdjacency<CITY_COUNT>* adjacency;
 
-StaticVector<int, CITY_COUNT> longestPath;
-StaticVector<int, CITY_COUNT> foundPath;
-StaticVector<int, CITY_COUNT> cityTimes(0);
+	int Next(int vertex, int last, const bool* visited) const {
+		const StaticBitset<CITY_COUNT>& row = adjacency->Row(vertex);
 
-// DFS that returns the path order
-LinkedList<int, CITY_COUNT> DFS(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& adjMatrix, bool visited[CITY_COUNT], int currentVertex) {
-	visited[currentVertex] = true;
-	LinkedList<int, CITY_COUNT> longestPath;
+		for (int neighbor = last == -1 ? row.FindFirst() : row.FindNext(last); neighbor != -1; neighbor = row.FindNext(neighbor)) {
+			if (!visited[neighbor])
+				return neighbor;
+		}
+		return -1;
+	}
+};
+
+// Visitor of DFS. Every vertex keeps the child with the longest path below it, the path of a vertex is the vertex
+// followed by the path of that child, so paths are never copied. When a longer child path is found the cities
+// of the old one are released like the recursive DFS did, the cities of the shorter paths stay visited.
+template <class Neighbors>
+struct ComponentDfsVisitor {
+	Neighbors neighbors;
+	bool* visited;
+	int bestChild[CITY_COUNT];
+	int pathLength[CITY_COUNT];
+
+	ComponentDfsVisitor(const Neighbors& vertexNeighbors, bool* visitedCities) : neighbors(vertexNeighbors), visited(visitedCities) {
+	}
 
-	for (int neighbor = 0; neighbor < CITY_COUNT; ++neighbor) {
-		if (adjMatrix[currentVertex][neighbor] >= (DISTANCE - TOLERANCE) && adjMatrix[currentVertex][neighbor] <= (DISTANCE + TOLERANCE) && !visited[neighbor]) {
+	bool Enter(int vertex) {
+		visited[vertex] = true;
+		bestChild[vertex] = -1;
+		pathLength[vertex] = 1;
+		return true;
+	}
 
-			LinkedList<int, CITY_COUNT> neighborPath = DFS(adjMatrix, visited, neighbor);
+	int NextNeighbor(int vertex, int last) const {
+		return neighbors.Next(vertex, last, visited);
+	}
 
-			if (neighborPath.GetSize() > longestPath.GetSize()) { // finding the max componenet size and it's visiting order
+	void Leave(int vertex) {
+	}
 
+	void Returned(int parent, int child) {
+		if (pathLength[child] <= pathLength[parent] - 1) // finding the max component size and it's visiting order
+			return;
 
-				LinkedListIterator<int, CITY_COUNT> longestPathIterator = longestPath.GetIterator();
+		for (int vertex = bestChild[parent]; vertex != -1; vertex = bestChild[vertex])
+			visited[vertex] = false;
 
-				while (longestPathIterator.HasNext()) {
-					int temp = longestPathIterator.Next();
-					visited[temp] = false;
-				}
+		bestChild[parent] = child;
+		pathLength[parent] = pathLength[child] + 1;
+	}
 
-				longestPath.Clear();
+	int LastVertex(int start) const {
+		while (bestChild[start] != -1)
+			start = bestChild[start];
+		return start;
+	}
 
-				LinkedListIterator<int, CITY_COUNT> llIterator = neighborPath.GetIterator();
+	void AppendPath(int start, StaticVector<int, CITY_COUNT>& path) const {
+		for (int vertex = start; vertex != -1; vertex = bestChild[vertex])
+			path.PushBack(vertex);
+	}
+};
 
-				while (llIterator.HasNext()) {
-					int temp = llIterator.Next();
-					visited[temp] = true;
-					longestPath.PushBack(temp);
+template <class Neighbors>
+int RunComponentDfs(const Neighbors& neighbors, bool visited[CITY_COUNT], int currentVertex, StaticVector<int, CITY_COUNT>& path) {
+	ComponentDfsVisitor<Neighbors> visitor(neighbors, visited);
+	DfsStack<CITY_COUNT> stack;
 
-				}
-			}
-		}
-	}
-	longestPath.Insert(longestPath.GetIterator(), currentVertex); // Insertin the current vertex to start of the path
+	RunDfs(currentVertex, stack, visitor);
 
-	return longestPath;
+	path = StaticVector<int, CITY_COUNT>();
+	visitor.AppendPath(currentVertex, path);
+	return path.GetSize();
 }
 
-// trying to find max connected vertices using dfs but doesn't work correctly
-void FindMaxConnectedVertices(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& adjMatrix) {
+// DFS that writes the path order to path, the current vertex followed by the longest path found below it. Returns the path size.
+int DFS(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& adjMatrix, bool visited[CITY_COUNT], int currentVertex,
+	StaticVector<int, CITY_COUNT>& path) {
+	MatrixBandNeighbors neighbors = { &adjMatrix };
+	return RunComponentDfs(neighbors, visited, currentVertex, path);
+}
 
-	StaticVector<bool, CITY_COUNT> visited(false);
-	LinkedList<int, CITY_COUNT> visitOrder;
+// Same DFS on the bit adjacency
+int DFS(const BitAdjacency<CITY_COUNT>& adjacency, bool visited[CITY_COUNT], int currentVertex, StaticVector<int, CITY_COUNT>& path) {
+	BitNeighbors neighbors = { &adjacency };
+	return RunComponentDfs(neighbors, visited, currentVertex, path);
+}
 
-	int startVertex = 80; // city plate number
+// trying to find max connected vertices using dfs but doesn't work correctly
+void FindMaxConnectedVertices(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& adjMatrix) {
 
+	StaticVector<int, CITY_COUNT> visitOrder;
 
-	for (startVertex = 0; startVertex < CITY_COUNT; ++startVertex) {
+	for (int startVertex = 0; startVertex < CITY_COUNT; ++startVertex) {
 
 		bool visited[CITY_COUNT] = { false };
-		LinkedList<int, CITY_COUNT> visitOrder;
 
-		visitOrder = DFS(adjMatrix, visited, startVertex);
+		DFS(adjMatrix, visited, startVertex, visitOrder);
 
-		//if(startVertex == CITY_COUNT - 1)
 		std::cout << "Visit order is: " << std::endl;
 		//std::cout << visitOrder;
 
 		std::cout << "Size of the final values are: " << visitOrder.GetSize() << std::endl;
 	}
-	/*
-
-	visitOrder = DFS(adjMatrix, visited, startVertex);
-
-	std::cout << "Found the final values " << std::endl;
-
-	std::cout << visitOrder << std::endl;
-
-	std::cout << "Size of the final values are: " << visitOrder.GetSize() << std::endl;
-	*/
 }
 
-// Tries to brute force and find longest path using dfs and returns the list, doesn't work because of visited array
-LinkedList<int, CITY_COUNT> DFSLongestPath(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& adjMatrix, bool visited[CITY_COUNT], int currentVertex, int targetVertex, int& maxDepth) {
-	visited[currentVertex] = true; // Set index as visited
-	LinkedList<int, CITY_COUNT> longestPath;
-
-	for (int neighbor = 0; neighbor < CITY_COUNT; ++neighbor) {
-		if (adjMatrix[currentVertex][neighbor] >= (DISTANCE - TOLERANCE) && adjMatrix[currentVertex][neighbor] <= (DISTANCE + TOLERANCE) && !visited[neighbor]) {
+// Runs DFS from every unvisited neighbor and keeps the longest path which ends at the target, the cities
+// of every search stay visited
+template <class Neighbors>
+int RunLongestPathDfs(const Neighbors& neighbors, bool visited[CITY_COUNT], int currentVertex, int targetVertex, int& maxDepth,
+	StaticVector<int, CITY_COUNT>& path) {
 
-			LinkedList<int, CITY_COUNT> neighborPath = DFS(adjMatrix, visited, neighbor);
+	visited[currentVertex] = true; // Set index as visited
+	ComponentDfsVisitor<Neighbors> visitor(neighbors, visited);
+	DfsStack<CITY_COUNT> stack;
+	int bestStart = -1;
 
-			if (neighborPath.GetSize() > maxDepth && neighborPath.Back() == targetVertex) { // finding the max componenet size and it's visiting order
+	for (int neighbor = neighbors.Next(currentVertex, -1, visited); neighbor != -1; neighbor = neighbors.Next(currentVertex, neighbor, visited)) {
+		RunDfs(neighbor, stack, visitor);
 
-				longestPath.Clear();
+		if (visitor.pathLength[neighbor] > maxDepth && visitor.LastVertex(neighbor) == targetVertex) {
+			bestStart = neighbor; // The cities of this path stay visited, so later searches don't change it
+			maxDepth = visitor.pathLength[neighbor];
+		}
+	}
 
-				LinkedListIterator<int, CITY_COUNT> llIterator = neighborPath.GetIterator();
+	path = StaticVector<int, CITY_COUNT>();
+	path.PushBack(currentVertex);
+	if (bestStart != -1)
+		visitor.AppendPath(bestStart, path);
 
-				while (llIterator.HasNext()) {
-					int temp = llIterator.Next();
-					longestPath.PushBack(temp);
-				}
+	return path.GetSize();
+}
 
-				maxDepth = neighborPath.GetSize();
-			}
-		}
-	}
-	longestPath.Insert(longestPath.GetIterator(), currentVertex); // Insertin the current vertex to start of the path
+// Tries to brute force and find longest path using dfs and writes it to path, doesn't work because of visited array
+int DFSLongestPath(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& adjMatrix, bool visited[CITY_COUNT], int currentVertex,
+	int targetVertex, int& maxDepth, StaticVector<int, CITY_COUNT>& path) {
+	MatrixBandNeighbors neighbors = { &adjMatrix };
+	return RunLongestPathDfs(neighbors, visited, currentVertex, targetVertex, maxDepth, path);
+}
 
-	return longestPath;
+// Bit adjacency version of DFSLongestPath
+int DFSLongestPath(const BitAdjacency<CITY_COUNT>& adjacency, bool visited[CITY_COUNT], int currentVertex, int targetVertex,
+	int& maxDepth, StaticVector<int, CITY_COUNT>& path) {
+	BitNeighbors neighbors = { &adjacency };
+	return RunLongestPathDfs(neighbors, visited, currentVertex, targetVertex, maxDepth, path);
 }
 
 // Finding the nearest neighbor and traversing through that path
@@ -162,24 +240,24 @@ int BFS(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& adjMatrix, int
 {
 	//  mark all distance with -1
 	StaticVector<int, CITY_COUNT> distances(-1);
-	LinkedList<int, CITY_COUNT> queue;
+	StaticRingQueue<int, CITY_COUNT> queue;
 
-	queue.PushBack(u);
+	queue.Push(u);
 
 	//  distance of u from u will be 0
 	distances.SetIndex(u, 0);
 
-	while (queue.GetSize() != 0)
+	while (!queue.IsEmpty())
 	{
 		int currentVertex = queue.Front();
 
-		queue.Erase(queue.GetIterator());
+		queue.Pop();
 		for (int neighbor = 0; neighbor < CITY_COUNT; ++neighbor) {
 			int distance = adjMatrix.GetIndex(currentVertex).GetIndex(neighbor);
 			if (distance > (DISTANCE - TOLERANCE) && distance < (DISTANCE + TOLERANCE)) {
 
 				if (distances.GetIndex(neighbor) == -1) {
-					queue.PushBack(neighbor);
+					queue.Push(neighbor);
 
 					distances.SetIndex(neighbor, distances.GetIndex(currentVertex) + 1);
 
@@ -218,12 +296,41 @@ void BFSSearchLongest(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& a
 
 // Creating graph for better usability assigning 0 if there are no paths between cities assigning the length if there is a path between
 void CreateGraph(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph, int distance, int tolerance) {
-	for (int i = 0; i < CITY_COUNT; ++i) {
-		for (int j = 0; j < CITY_COUNT; ++j) {
-			if (graph[i][j] > distance + tolerance || graph[i][j] < distance - tolerance)
-				graph[i][j] = 0;
-		}
-	}
+	FilterBand<CITY_COUNT>(graph, graph, NULL, distance - tolerance, distance + tolerance);
+}
+
+// Writes the filtered source graph into graph without changing the source, used to refill per thread buffers
+void CreateGraph(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& source, StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph,
+	int distance, int tolerance) {
+	FilterBand<CITY_COUNT>(source, graph, NULL, distance - tolerance, distance + tolerance);
+}
+
+// Filters the graph like CreateGraph and builds the bit adjacency of the filtered graph in the same pass
+void CreateGraph(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph, BitAdjacency<CITY_COUNT>& adjacency, int distance, int tolerance) {
+	FilterBand<CITY_COUNT>(graph, graph, &adjacency, distance - tolerance, distance + tolerance);
+}
+
+// Combination score of a city used to order the cities, all algorithms have weight 1
+double CalculateTotalScore(int node, StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph, bool visited[CITY_COUNT],
+	FirstOrderNeighbors<int, CITY_COUNT>& firstOrderNeighbors, SecondOrderNeighbors<int, CITY_COUNT>& secondOrderNeighbors,
+	ThirdOrderNeighbors<int, CITY_COUNT>& thirdOrderNeighbors, ClosenessCentrality<int, CITY_COUNT>& closenessCentrality) {
+
+	return firstOrderNeighbors.Score(node, graph, visited) + secondOrderNeighbors.Score(node, graph, visited)
+		+ closenessCentrality.Score(node, graph, visited) + thirdOrderNeighbors.Score(node, graph, visited);
+}
+
+// Calculates the combination score of every city once, scores[i] is the score of city i
+void CalculateTotalScores(StaticVector<double, CITY_COUNT>& scores, StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph) {
+	ClosenessCentrality<int, CITY_COUNT> closenessCentrality;
+	FirstOrderNeighbors<int, CITY_COUNT> firstOrderNeighbors;
+	SecondOrderNeighbors<int, CITY_COUNT> secondOrderNeighbors;
+	ThirdOrderNeighbors<int, CITY_COUNT> thirdOrderNeighbors;
+
+	bool visited[CITY_COUNT] = { false };
+
+	scores = StaticVector<double, CITY_COUNT>();
+	for (int i = 0; i < CITY_COUNT; ++i)
+		scores.PushBack(CalculateTotalScore(i, graph, visited, firstOrderNeighbors, secondOrderNeighbors, thirdOrderNeighbors, closenessCentrality));
 }
 
 // Compare two cities according to their score combination
@@ -238,11 +345,8 @@ int Compare(int node1, int node2, StaticVector<StaticVector<int, CITY_COUNT>, CI
 
 	//calculates score for node 1 and node 2 
 
-	double node1Score = firstOrderNeighbors.Score(node1, graph, visited) + secondOrderNeighbors.Score(node1, graph, visited) 
-		+ closenessCentrality.Score(node1, graph, visited) + thirdOrderNeighbors.Score(node1, graph, visited);
-
-	double node2Score = firstOrderNeighbors.Score(node2, graph, visited) + secondOrderNeighbors.Score(node2, graph, visited) 
-		+ closenessCentrality.Score(node2, graph, visited) + thirdOrderNeighbors.Score(node2, graph, visited);
+	double node1Score = CalculateTotalScore(node1, graph, visited, firstOrderNeighbors, secondOrderNeighbors, thirdOrderNeighbors, closenessCentrality);
+	double node2Score = CalculateTotalScore(node2, graph, visited, firstOrderNeighbors, secondOrderNeighbors, thirdOrderNeighbors, closenessCentrality);
 
 	if (node1Score > node2Score)
 		return 1;
@@ -251,59 +355,103 @@ int Compare(int node1, int node2, StaticVector<StaticVector<int, CITY_COUNT>, CI
 
 }
 
+// Score used for ordering. An isolated city scores NaN (-inf from 1 - 1/0 plus inf from closeness), NaN
+// compares false with everything and breaks the ordering stable_sort needs, so it ranks lowest.
+double SortKey(double score) {
+	return std::isnan(score) ? -std::numeric_limits<double>::infinity() : score;
+}
+
+// Sorts the cities by descending score, cities with equal scores keep their order
+void SortCitiesByScore(StaticVector<int, CITY_COUNT>& sortedCities, StaticVector<double, CITY_COUNT>& scores) {
+	int* cities = &sortedCities[0];
+
+	std::stable_sort(cities, cities + sortedCities.GetSize(), [&scores](int city1, int city2) {
+		return SortKey(scores[city1]) > SortKey(scores[city2]);
+	});
+}
+
+// Sorting the cities according to their combination scores, each score is calculated once and returned in scores
+void CalculateTotalScoreAndSort(StaticVector<int, CITY_COUNT>& sortedCities, StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph,
+	StaticVector<double, CITY_COUNT>& scores) {
+
+	CalculateTotalScores(scores, graph);
+	SortCitiesByScore(sortedCities, scores);
+}
+
 // Sorting the cities according to their combination scores
 void CalculateTotalScoreAndSort(StaticVector<int, CITY_COUNT>& sortedCities, StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph) {
-	// Uses insertion sort to sort cities
-	int i, j;
-	int key;
-	for (i = 1; i < CITY_COUNT; i++) {
-		key = sortedCities[i];
-		j = i - 1;
-
-		while (j >= 0 && Compare(key, sortedCities[j], graph)) {
-			sortedCities[j + 1] = sortedCities[j];
-			j = j - 1;
-		}
-		sortedCities[j + 1] = key;
-	}
+	StaticVector<double, CITY_COUNT> scores;
+	CalculateTotalScoreAndSort(sortedCities, graph, scores);
 }
 
-// finds the longest path between two given nodes using dfs but it takes long so i have to manually stop it
-bool LongestPath(int currentNode, int endNode, StaticVector<int, CITY_COUNT>& currentPath, StaticVector<StaticVector<int, CITY_COUNT>, 
-	CITY_COUNT>& graph, bool visited[CITY_COUNT]) {
-	
-	visited[currentNode] = true;
-	currentPath.PushBack(currentNode);
-	cityTimes[currentNode]++;
+// Visits of LongestPath, every simple path from the start is walked and the ones reaching the end node are compared
+struct LongestPathVisitor {
+	static const int MAX_CITY_TIMES = 10000000;
+
+	StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>* graph;
+	bool* visited;
+	StaticVector<int, CITY_COUNT>* currentPath;
+	SolverContext* context;
+	int endNode;
+
+	bool Enter(int vertex) {
+		visited[vertex] = true;
+		currentPath->PushBack(vertex);
+		context->cityTimes[vertex]++;
+
+		if (context->cityTimes[vertex] > MAX_CITY_TIMES) { // If we traverse through a city more than 10000000 algorithm stops. 
+			visited[vertex] = false;
+			currentPath->PopBack();
+			return false;
+		}
+
+		if (vertex == endNode) { // If path encounter with endNode it checks whether the new path is longer than old path
+			if (currentPath->GetSize() > context->longestPath.GetSize()) { // then if new path is longer than longest path it assigns new path as longest path
+				context->longestPath = *currentPath;
+				std::cout << "Longest path is " << std::endl << context->longestPath;
+			}
+		}
 
-	if (cityTimes[currentNode] > 10000000) { // If we traverse through a city more than 10000000 algorithm stops. 
-		visited[currentNode] = false;
-		currentPath.PopBack();
 		return true;
 	}
 
-	if (currentNode == endNode) { // If path encounter with endNode it checks whether the new path is longer than old path
-		if (currentPath.GetSize() > longestPath.GetSize()) { // then if new path is longer than longest path it assigns new path as longest path
-			longestPath = currentPath;
-			std::cout << "Longest path is " << std::endl << longestPath;
+	int NextNeighbor(int vertex, int last) const {
+		if (vertex == endNode) // The path ends here
+			return -1;
+
+		for (int neighbor = last + 1; neighbor < CITY_COUNT; ++neighbor) {
+			if (!visited[neighbor] && (*graph)[vertex][neighbor] && context->cityTimes[neighbor] <= MAX_CITY_TIMES)
+				return neighbor;
 		}
+		return -1;
 	}
-	else {
-		for (int neighbor = 0; neighbor < CITY_COUNT; ++neighbor) {
-			
-			if (!visited[neighbor] && graph[currentNode][neighbor] && cityTimes[neighbor] <= 10000000) {
-				if (LongestPath(neighbor, endNode, currentPath, graph, visited)) // If current node is not encountered with end node it continues to search for it from different paths
-					return true;
-			}
-		}
+
+	// If path can't find a solution it backtracks to the first place that has neighbor
+	void Leave(int vertex) {
+		visited[vertex] = false;
+		currentPath->PopBack();
+	}
+
+	void Returned(int parent, int child) {
 	}
+};
 
-	visited[currentNode] = false;
-	currentPath.PopBack();
-	return false; // If path can't find a solution it backtracks to the first place that has neighbor
+// finds the longest path between two given nodes using dfs but it takes long so i have to manually stop it
+// The best path is kept in context.longestPath, context.cityTimes counts the visits. Returns true when the
+// search was stopped, then the cities of the stopped path stay visited and in currentPath.
+bool LongestPath(int currentNode, int endNode, StaticVector<int, CITY_COUNT>& currentPath, StaticVector<StaticVector<int, CITY_COUNT>, 
+	CITY_COUNT>& graph, bool visited[CITY_COUNT], SolverContext& context) {
+
+	LongestPathVisitor visitor = { &graph, visited, &currentPath, &context, endNode };
+	DfsStack<CITY_COUNT> stack;
+
+	return !RunDfs(currentNode, stack, visitor);
 }
 
-void FindMaximumPathTotalScore(int startingCity, StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph) {
+// Uses scores calculated by CalculateTotalScores, so the scores can be reused for different starting cities.
+// The path is left in context.foundPath.
+void FindMaximumPathTotalScore(int startingCity, StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph,
+	StaticVector<double, CITY_COUNT>& scores, SolverContext& context) {
 	bool visited[CITY_COUNT] = { false };
 	StaticVector<int, CITY_COUNT> sortedCities;
 	bool sortedVisited[CITY_COUNT] = { false };
@@ -311,9 +459,11 @@ void FindMaximumPathTotalScore(int startingCity, StaticVector<StaticVector<int,
 	for (int i = 0; i < CITY_COUNT; ++i)
 		sortedCities.PushBack(i);
 
-	CalculateTotalScoreAndSort(sortedCities, graph); // sorts the cities according to their scores
+	SortCitiesByScore(sortedCities, scores); // sorts the cities according to their scores
 	
-	StaticVector<int, CITY_COUNT> foundPath;
+	context.Reset();
+	StaticVector<int, CITY_COUNT>& foundPath = context.foundPath;
+	StaticVector<int, CITY_COUNT>& longestPath = context.longestPath;
 	int currentNode = startingCity;
 
 	// Traversing in sorted cities list for one time to create path
@@ -330,7 +480,7 @@ void FindMaximumPathTotalScore(int startingCity, StaticVector<StaticVector<int,
 
 		visited[currentNode] = true;
 
-		if (!LongestPath(currentNode, sortedCities[i], currentPath, graph, visited)) {
+		if (!LongestPath(currentNode, sortedCities[i], currentPath, graph, visited, context)) {
 			std::cout << "No path between " << currentNode << "  " << sortedCities[i] << std::endl;
 			continue;
 		}
@@ -357,14 +507,24 @@ void FindMaximumPathTotalScore(int startingCity, StaticVector<StaticVector<int,
 
 }
 
-// Finds longest path using different algorithms
+void FindMaximumPathTotalScore(int startingCity, StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph, SolverContext& context) {
+	StaticVector<double, CITY_COUNT> scores;
+	CalculateTotalScores(scores, graph);
+
+	FindMaximumPathTotalScore(startingCity, graph, scores, context);
+}
+
+// Finds longest path using different algorithms, visited cities are pushed to path if it is not NULL
 int FindLongestPathAlgorithms(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph, bool visited[CITY_COUNT], 
-	int startingCity, int prevCity, Algorithms<int, CITY_COUNT>& algorithm) {
+	int startingCity, int prevCity, Algorithms<int, CITY_COUNT>& algorithm, StaticVector<int, CITY_COUNT>* path) {
 	
 	if (prevCity != -1) { // Blocking the previous city paths, not to visit again
 		for (int i = 0; i < CITY_COUNT; ++i) graph[prevCity][i] = 0;
 		for (int i = 0; i < CITY_COUNT; ++i) graph[i][prevCity] = 0;
+		algorithm.RemoveVertex(prevCity);
 	}
+	else
+		algorithm.Prepare(graph);
 	
 	visited[startingCity] = true;
 
@@ -383,22 +543,35 @@ int FindLongestPathAlgorithms(StaticVector<StaticVector<int, CITY_COUNT>, CITY_C
 	}
 
 	if (highestScoreIndex != -1) { // If there is a highest score found then it pushes to found path then recursively continue with the neighbor
-		//foundPath.PushBack(highestScoreIndex);
-		return 1 + FindLongestPathAlgorithms(graph, visited, highestScoreIndex, startingCity, algorithm);
+		if (path != NULL)
+			path->PushBack(highestScoreIndex);
+		return 1 + FindLongestPathAlgorithms(graph, visited, highestScoreIndex, startingCity, algorithm, path);
 	}
 	
 	return 1;
 }
 
-// Finds the longest path using combination of algoritmhs
+int FindLongestPathAlgorithms(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph, bool visited[CITY_COUNT],
+	int startingCity, int prevCity, Algorithms<int, CITY_COUNT>& algorithm) {
+	return FindLongestPathAlgorithms(graph, visited, startingCity, prevCity, algorithm, NULL);
+}
+
+// Finds the longest path using weighted combination of algorithms, visited cities are pushed to path if it is not NULL
 int FindLongestPathCombination(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph, bool visited[CITY_COUNT],
-	int startingCity, int prevCity, Algorithms<int, CITY_COUNT>** algorithms) {
+	int startingCity, int prevCity, Algorithms<int, CITY_COUNT>** algorithms, const double* weights, int algorithmCount,
+	StaticVector<int, CITY_COUNT>* path) {
 
 	if (prevCity != -1) { // Blocking the previous city paths not to visit again
 		for (int i = 0; i < CITY_COUNT; ++i) 
 			graph[prevCity][i] = 0;
 		for (int i = 0; i < CITY_COUNT; ++i) 
 			graph[i][prevCity] = 0;
+		for (int i = 0; i < algorithmCount; ++i)
+			algorithms[i]->RemoveVertex(prevCity);
+	}
+	else {
+		for (int i = 0; i < algorithmCount; ++i) // Search starts, letting the algorithms cache the graph
+			algorithms[i]->Prepare(graph);
 	}
 
 	visited[startingCity] = true;
@@ -408,8 +581,9 @@ int FindLongestPathCombination(StaticVector<StaticVector<int, CITY_COUNT>, CITY_
 
 	for (int i = 0; i < CITY_COUNT; ++i){
 		if (graph[startingCity][i]) {
-			double tempScore = -1 * algorithms[0]->Score(i, graph, visited) + 1 * algorithms[1]->Score(i, graph, visited)  // finds score combination for the neighbors
-				+ 1 * algorithms[2]->Score(i, graph, visited) + 1 * algorithms[3]->Score(i, graph, visited);
+			double tempScore = 0; // finds score combination for the neighbors
+			for (int j = 0; j < algorithmCount; ++j)
+				tempScore += weights[j] * algorithms[j]->Score(i, graph, visited);
 			
 			if (tempScore > highestScore) { // selects the neighbor with the highest score
 				highestScore = tempScore;
@@ -420,11 +594,121 @@ int FindLongestPathCombination(StaticVector<StaticVector<int, CITY_COUNT>, CITY_
 	}
 
 	if (highestScoreIndex != -1) { // If there is a highest score found then it pushes to found path then recursively continue with the neighbor
-		foundPath.PushBack(highestScoreIndex);
-		return 1 + FindLongestPathCombination(graph, visited, highestScoreIndex, startingCity, algorithms);
+		if (path != NULL)
+			path->PushBack(highestScoreIndex);
+		return 1 + FindLongestPathCombination(graph, visited, highestScoreIndex, startingCity, algorithms, weights, algorithmCount, path);
 
 	}
 		
 	return 1;
 }
 
+// Same search as FindLongestPathCombination with a ScoreComposer, the terms are not called through the virtual table
+// and the neighbor terms score on the bit rows the composer keeps. Works for any graph size N.
+template <class Composer, unsigned int N>
+int FindLongestPathComposed(StaticVector<StaticVector<int, N>, N>& graph, bool visited[N],
+	int startingCity, int prevCity, Composer& composer, StaticVector<int, N>* path) {
+
+	if (prevCity != -1) { // Blocking the previous city paths not to visit again
+		for (int i = 0; i < N; ++i)
+			graph[prevCity][i] = 0;
+		for (int i = 0; i < N; ++i)
+			graph[i][prevCity] = 0;
+		composer.RemoveVertex(prevCity);
+	}
+	else
+		composer.Prepare(graph);
+
+	visited[startingCity] = true;
+
+	StaticBitset<N> visitedBits; // Bit copy of visited for the terms scoring on the composer's bit rows
+	for (int i = 0; i < N; ++i) {
+		if (visited[i])
+			visitedBits.Set(i);
+	}
+
+	double highestScore = 0;
+	int highestScoreIndex = -1;
+
+	for (int i = 0; i < N; ++i) {
+		if (graph[startingCity][i]) {
+			double tempScore = composer.Score(i, graph, visited, visitedBits);
+
+			if (tempScore > highestScore) { // selects the neighbor with the highest score
+				highestScore = tempScore;
+				highestScoreIndex = i;
+			}
+		}
+	}
+
+	if (highestScoreIndex != -1) {
+		if (path != NULL)
+			path->PushBack(highestScoreIndex);
+		return 1 + FindLongestPathComposed(graph, visited, highestScoreIndex, startingCity, composer, path);
+	}
+
+	return 1;
+}
+
+template <class Composer, unsigned int N>
+int FindLongestPathComposed(StaticVector<StaticVector<int, N>, N>& graph, bool visited[N], int startingCity, int prevCity, Composer& composer) {
+	return FindLongestPathComposed(graph, visited, startingCity, prevCity, composer, static_cast<StaticVector<int, N>*>(NULL));
+}
+
+// Same search as FindLongestPathComposed on the bit rows of a filtered graph, for graphs kept up to date elsewhere like
+// IncrementalBandGraph. The composer is prepared from a copy of the rows and the cities left behind are removed from that
+// copy only, so neither adjacency nor graph is modified. graph is only read by the terms without a bit row Score.
+template <class Composer, unsigned int N>
+int FindLongestPathComposedMasked(const BitAdjacency<N>& adjacency, StaticVector<StaticVector<int, N>, N>& graph, bool visited[N],
+	int startingCity, Composer& composer) {
+
+	composer.Prepare(adjacency);
+
+	StaticBitset<N> visitedBits;
+	for (int i = 0; i < N; ++i) {
+		if (visited[i])
+			visitedBits.Set(i);
+	}
+
+	int count = 1;
+	int city = startingCity;
+
+	while (true) {
+		visited[city] = true;
+		visitedBits.Set(city);
+
+		double highestScore = 0;
+		int highestScoreIndex = -1;
+
+		// Row of the composer, the removed cities are already cleared in it
+		const StaticBitset<N>& neighbors = composer.GetAdjacency().Row(city);
+		for (int i = neighbors.FindFirst(); i != -1; i = neighbors.FindNext(i)) {
+			double tempScore = composer.Score(i, graph, visited, visitedBits);
+
+			if (tempScore > highestScore) {
+				highestScore = tempScore;
+				highestScoreIndex = i;
+			}
+		}
+
+		if (highestScoreIndex == -1)
+			return count;
+
+		composer.RemoveVertex(city);
+		city = highestScoreIndex;
+		count++;
+	}
+}
+
+// Finds the longest path using combination of first, second, third order neighbors and closeness centrality
+int FindLongestPathCombination(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph, bool visited[CITY_COUNT],
+	int startingCity, int prevCity, Algorithms<int, CITY_COUNT>** algorithms, StaticVector<int, CITY_COUNT>* path) {
+	return FindLongestPathCombination(graph, visited, startingCity, prevCity, algorithms, COMBINATION_WEIGHTS, 4, path);
+}
+
+// Finds the longest path using combination of algorithms and pushes the visited cities to context.foundPath
+int FindLongestPathCombination(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph, bool visited[CITY_COUNT],
+	int startingCity, int prevCity, Algorithms<int, CITY_COUNT>** algorithms, SolverContext& context) {
+	return FindLongestPathCombination(graph, visited, startingCity, prevCity, algorithms, &context.foundPath);
+}
+
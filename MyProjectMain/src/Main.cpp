@@ -14,49 +14,57 @@
 #include <Algorithms.h>
 #include <HeuristicApproaches.cpp>
 #include <GeneticAlgorithm.cpp>
+#include <LocalSearch.h>
+#include <ExactLongestPath.h>
+#include <ParameterSweep.cpp>
+#include <MultiStart.cpp>
+#include <RuntimeSolver.cpp>
+#include <WorkStealingThreadPool.h>
+#include <ProblemConfig.h>
+
+
+#define EXACT_SOLVER_TIME_BUDGET 10000 // milliseconds
+
+// Bands kept in the binary cache of the table
+std::vector<GraphCacheBand> GetDefaultCacheBands() {
+	std::vector<GraphCacheBand> bands;
+	bands.push_back(GraphCacheBand{ DISTANCE - TOLERANCE, DISTANCE + TOLERANCE });
+	return bands;
+}
 
+// Writing the table read from the CSV file into StaticVectors. The solvers working on StaticVectors are built for CITY_COUNT
+// cities, a table with another city count is reported and false is returned so they don't run on part of it.
+bool readCSVFile(const RuntimeGraph& table, StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& cityDistances,
+	StaticVector<std::string, CITY_COUNT>& cityNames) {
 
-#define CITY_COUNT 81
-#define START 5
-
-// Reading CSV file and writing into StaticVectors
-void readCSVFile(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& cityDistances, StaticVector<std::string, CITY_COUNT>& cityNames) {
-	std::ifstream file("ilmesafe.csv", std::ios::in | std::ios::binary); // Open the CSV file
-
-	if (file.is_open()) {
-		std::string line;
-		int i = 0;
-		int j = 0;
-
-		std::getline(file, line);
-		std::getline(file, line);
-		while (std::getline(file, line)) {
-			std::istringstream iss(line);
-			std::string token;
-			std::getline(iss, token, ';'); // city plate
-
-			std::getline(iss, token, ';'); // city name
-			cityNames[i] = token;
-
-
-			while (std::getline(iss, token, ';')) {
-				int value;
-				std::istringstream(token) >> value;
-				cityDistances[i][j] = value;
-				j++;
-			}
+	if (table.GetCityCount() != CITY_COUNT) {
+		std::cerr << "ilmesafe.csv has " << table.GetCityCount() << " cities but the fixed size solvers are built for "
+			<< CITY_COUNT << " (CITY_COUNT), only the runtime sized combination search runs" << std::endl;
+		return false;
+	}
 
-			i++;
-			j = 0;
+	for (int i = 0; i < CITY_COUNT; ++i) {
+		cityNames[i] = table.GetNames()[i];
+		for (int j = 0; j < CITY_COUNT; ++j)
+			cityDistances[i][j] = table.Distance(i, j);
+	}
 
-			if (i == CITY_COUNT)
-				break;
-		}
+	return true;
+}
 
-		file.close(); // Close the CSV file
-	}
-	else
-		std::cout << "File is not open" << std::endl;
+// Same table with its size found at runtime, the search picks the fixed size fast path the table fits in.
+// This is the only search that is sized at runtime. graphCache is the cache the table was read with.
+void RunRuntimeSizedSearch(RuntimeGraph& runtimeGraph, const GraphCache& graphCache) {
+	if (!graphCache.LoadBand(runtimeGraph, DISTANCE - TOLERANCE, DISTANCE + TOLERANCE))
+		runtimeGraph.FilterBand(DISTANCE - TOLERANCE, DISTANCE + TOLERANCE);
+	CityPath runtimePath = runtimeGraph.CreatePath();
+	int startingCity = START < runtimeGraph.GetCityCount() ? START : 0;
+
+	std::cout << "Runtime graph with " << runtimeGraph.GetCityCount() << " cities, fixed size "
+		<< GetFixedGraphSize(runtimeGraph.GetCityCount()) << std::endl;
+	std::cout << "Found score is: " << FindLongestPathDispatch(runtimeGraph, startingCity, runtimePath) << std::endl;
+	std::cout << runtimePath;
+	std::cout << "-------------------------------------" << std::endl;
 }
 
 // Testing the static vector and linked list classes
@@ -165,7 +173,7 @@ void FindMinimumDistanceTolerance(StaticVector<StaticVector<int, CITY_COUNT>, CI
 			for (int i = 0; i < CITY_COUNT; ++i) visited[i] = false;
 
 			std::cout << "Testing for " << distance << " and " << tolerance << std::endl;
- 			int score = FindLongestPathCombination(graph1, visited, START, -1, algorithms);
+			int score = FindLongestPathCombination(graph1, visited, START, -1, algorithms, NULL);
 			std::cout << "Found score is " << score << std::endl;
 
 			if (score >= maximumResult) {
@@ -216,7 +224,18 @@ int main() {
 	StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT> cityDistances;
 	StaticVector<std::string, CITY_COUNT> cityNames;
 
-	readCSVFile(cityDistances, cityNames);
+	// Read once, the fixed size solvers get a copy and the runtime sized search uses the table itself
+	std::unique_ptr<RuntimeGraph> table;
+	GraphCache cache;
+	if (!ReadDistanceTableCached("ilmesafe.csv", "ilmesafe.graph", table, cache, GetDefaultCacheBands())) {
+		std::cerr << "ilmesafe.csv can't be read" << std::endl;
+		return 0;
+	}
+
+	if (!readCSVFile(*table, cityDistances, cityNames)) {
+		RunRuntimeSizedSearch(*table, cache);
+		return 0;
+	}
 
 	CreateGraph(cityDistances, DISTANCE, TOLERANCE);
 	
@@ -233,7 +252,11 @@ int main() {
 	algorithms[3] = &closenessCentrality;
 
 
-	FindMinimumDistanceTolerance(cityDistances, algorithms);
+	WorkStealingThreadPool threadPool;
+	SweepGrid sweepGrid;
+	sweepGrid.startingCity = START;
+	SweepResult sweepResult = FindMinimumDistanceToleranceIncremental(cityDistances, threadPool, sweepGrid);
+	PrintSweepReport(sweepResult, threadPool.GetThreadCount());
 
 
 
@@ -270,7 +293,20 @@ int main() {
 	for (int i = 0; i < CITY_COUNT; ++i) visited[i] = false;
 	StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT> graph7 = cityDistances;
 	std::cout << "Betweenness Centrality Score " << std::endl;
-	//std::cout << "Found score is: " << FindLongestPathAlgorithms(graph7, visited, START, -1, bcbetweennessCentrality << std::endl;
+	betweennessCentrality.SetThreadPool(&threadPool);
+	std::cout << "Found score is: " << FindLongestPathAlgorithms(graph7, visited, START, -1, betweennessCentrality) << std::endl;
+	std::cout << "-------------------------------------" << std::endl;
+
+	// Betweenness as fifth term of the combination
+	Algorithms<int, CITY_COUNT>* algorithmsWithBetweenness[5] = { &firstOrderNeighbors, &secondOrderNeighbors,
+		&thirdOrderNeighbors, &closenessCentrality, &betweennessCentrality };
+	const double weightsWithBetweenness[5] = { -1, 1, 1, 1, 1 };
+
+	for (int i = 0; i < CITY_COUNT; ++i) visited[i] = false;
+	StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT> graph8 = cityDistances;
+	std::cout << "Combination With Betweenness Centrality " << std::endl;
+	std::cout << "Found score is: " << FindLongestPathCombination(graph8, visited, START, -1, algorithmsWithBetweenness,
+		weightsWithBetweenness, 5, NULL) << std::endl;
 	std::cout << "-------------------------------------" << std::endl;
 
 	
@@ -279,13 +315,13 @@ int main() {
 	std::string fileName = "results/";
 	
 	int j = START;
+	SolverContext solverContext;
 	
 	//for (int j = 0; j < CITY_COUNT; ++j) {
-		foundPath = StaticVector<int, CITY_COUNT>();
-		StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT> graph5 = cityDistances;
-		for (int i = 0; i < CITY_COUNT; ++i) visited[i] = false;
+		solverContext.PrepareGraph(cityDistances);
+		StaticVector<int, CITY_COUNT>& foundPath = solverContext.foundPath;
 		foundPath.PushBack(j);
-		std::cout << "Combination for city: " << j << "->" << FindLongestPathCombination(graph5, visited, j, -1, algorithms) << std::endl;
+		std::cout << "Combination for city: " << j << "->" << FindLongestPathCombination(solverContext.graph, solverContext.visited, j, -1, algorithms, solverContext) << std::endl;
 		std::cout << "Found path size is " << foundPath.GetSize() << std::endl;
 		std::cout << foundPath;
 	
@@ -296,6 +332,20 @@ int main() {
 			correctPathCount++;
 		}
 
+		// Validating the greedy result with the exact solver
+		BitAdjacency<CITY_COUNT> adjacency;
+		adjacency.Build(cityDistances);
+		ExactLongestPathSolver<CITY_COUNT> exactSolver;
+		ExactLongestPathResult<CITY_COUNT> exactResult = exactSolver.Solve(adjacency, j, EXACT_SOLVER_TIME_BUDGET);
+
+		if (exactResult.certified)
+			std::cout << "Exact longest path is " << exactResult.lowerBound << " cities";
+		else
+			std::cout << "Exact longest path is between " << exactResult.lowerBound << " and " << exactResult.upperBound << " cities";
+		std::cout << ", greedy found " << foundPath.GetSize() << " (" << exactResult.expandedStates << " states in "
+			<< exactResult.elapsedMilliseconds << " ms)" << std::endl;
+		std::cout << exactResult.path;
+
 		std::cout << "-------------------------------------" << std::endl;
 	//}
 	std::cout << "-------------------------------------" << std::endl;
@@ -304,6 +354,46 @@ int main() {
 	std::cout << "Correct path count is: " << correctPathCount << std::endl;
 	std::cout << "-------------------------------------" << std::endl;
 
+	// Every heuristic from every starting city, one starting city per task
+	std::cout << "Heuristics from every starting city" << std::endl;
+	MultiStartResult multiStartResult = FindLongestPathsFromAllCities(cityDistances, threadPool);
+	PrintMultiStartReport(multiStartResult, threadPool.GetThreadCount());
+	std::cout << "-------------------------------------" << std::endl;
+
+	RunRuntimeSizedSearch(*table, cache);
+
+	// Island genetic algorithm, one island per task with migrations between them
+	GeneticAlgorithmResult<int, CITY_COUNT> geneticResult = IslandGeneticAlgorithm(cityDistances, threadPool);
+	std::cout << "Island genetic algorithm found fitness " << geneticResult.best.fitnessScore << " on island " << geneticResult.bestIsland
+		<< " after " << geneticResult.generations << " generations and " << geneticResult.migrations << " migrations in "
+		<< geneticResult.milliseconds << " ms" << std::endl;
+	std::cout << geneticResult.best.gnome;
+	PrintGenerationStats(geneticResult.generationStats, 100);
+	std::cout << "-------------------------------------" << std::endl;
+
+	// Simulated annealing alone, growing a path from the starting city until its time budget is used
+	std::unique_ptr<BitAdjacency<CITY_COUNT>> searchBand(new BitAdjacency<CITY_COUNT>());
+	BuildBandAdjacency(cityDistances, *searchBand, DISTANCE - TOLERANCE, DISTANCE + TOLERANCE);
+
+	LocalSearchConfig searchConfig;
+	searchConfig.iterations = 5000000;
+	searchConfig.timeBudgetMilliseconds = 200;
+
+	int searchPath[CITY_COUNT] = { START };
+	int searchLength = 1;
+	StaticBitset<CITY_COUNT> searchMembers;
+	searchMembers.Set(START);
+	RandomGenerator searchRandom(SolverContext::DEFAULT_SEED);
+
+	std::unique_ptr<LocalSearch<int, CITY_COUNT>> localSearch(new LocalSearch<int, CITY_COUNT>());
+	LocalSearchResult searchResult = localSearch->Run(*searchBand, searchConfig, searchPath, searchLength, searchMembers, searchRandom);
+	std::cout << "Simulated annealing found fitness " << searchResult.bestFitness << " after " << searchResult.iterations
+		<< " moves (" << searchResult.acceptedMoves << " accepted) in " << searchResult.milliseconds << " ms" << std::endl;
+	for (int i = 0; i < searchLength; ++i)
+		std::cout << searchPath[i] << " ";
+	std::cout << std::endl;
+	std::cout << "-------------------------------------" << std::endl;
+
 	// -------------------------------------------------------------------------------------------- \\
 	
 	//GeneticAlgorithmUtil<int, CITY_COUNT>(cityDistances);
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <Algorithms.h>
+#include <StaticVectorLibrary.h>
+#include <WorkStealingThreadPool.h>
+#include <HeuristicApproaches.cpp>
+
+// Heuristics run from every starting city, the combination is the same as FindLongestPathCombination
+enum MultiStartHeuristic {
+	MULTI_START_COMBINATION,
+	MULTI_START_FIRST_ORDER,
+	MULTI_START_SECOND_ORDER,
+	MULTI_START_THIRD_ORDER,
+	MULTI_START_CLOSENESS,
+	MULTI_START_HEURISTIC_COUNT
+};
+
+inline const char* GetMultiStartHeuristicName(int heuristic) {
+	static const char* names[MULTI_START_HEURISTIC_COUNT] = { "Combination", "First", "Second", "Third", "Closeness" };
+	return names[heuristic];
+}
+
+struct MultiStartCityResult {
+	int startingCity = 0;
+	int lengths[MULTI_START_HEURISTIC_COUNT] = { 0 };
+	int bestHeuristic = 0;
+	StaticVector<int, CITY_COUNT> bestPath; // Starts with the starting city
+	double milliseconds = 0;
+	int worker = -1;
+};
+
+struct MultiStartResult {
+	int bestCity = 0;
+	int bestHeuristic = 0;
+	int bestLength = 0;
+	double wallMilliseconds = 0;
+	std::vector<MultiStartCityResult> cities; // Indexed by starting city
+};
+
+// Solver context and heuristic objects owned by one worker thread, the heuristics cache the graph they
+// are prepared with so they can't be shared between threads
+struct MultiStartWorker {
+	SolverContext context;
+	CombinationScorer scorer;
+	FirstOrderNeighbors<int, CITY_COUNT> firstOrderNeighbors;
+	SecondOrderNeighbors<int, CITY_COUNT> secondOrderNeighbors;
+	ThirdOrderNeighbors<int, CITY_COUNT> thirdOrderNeighbors;
+	ClosenessCentrality<int, CITY_COUNT> closenessCentrality;
+};
+
+// Runs one heuristic from startingCity on a fresh copy of graph, the found path is left in the worker's context.foundPath
+int RunMultiStartHeuristic(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph, MultiStartWorker& worker,
+	int heuristic, int startingCity) {
+
+	SolverContext& context = worker.context;
+	context.PrepareGraph(graph); // The search removes visited cities from the graph
+	context.foundPath.PushBack(startingCity);
+
+	switch (heuristic) {
+	case MULTI_START_FIRST_ORDER:
+		return FindLongestPathAlgorithms(context.graph, context.visited, startingCity, -1, worker.firstOrderNeighbors, &context.foundPath);
+	case MULTI_START_SECOND_ORDER:
+		return FindLongestPathAlgorithms(context.graph, context.visited, startingCity, -1, worker.secondOrderNeighbors, &context.foundPath);
+	case MULTI_START_THIRD_ORDER:
+		return FindLongestPathAlgorithms(context.graph, context.visited, startingCity, -1, worker.thirdOrderNeighbors, &context.foundPath);
+	case MULTI_START_CLOSENESS:
+		return FindLongestPathAlgorithms(context.graph, context.visited, startingCity, -1, worker.closenessCentrality, &context.foundPath);
+	default:
+		return FindLongestPathComposed(context.graph, context.visited, startingCity, -1, worker.scorer, &context.foundPath);
+	}
+}
+
+// Runs the heuristics from every starting city of the band filtered graph. A task is one starting city, every worker
+// has its own graph buffer, path and heuristics so nothing is written to shared state. Ties go to the earlier
+// heuristic and the earlier city so the result is the same for any thread count.
+MultiStartResult FindLongestPathsFromAllCities(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& graph, WorkStealingThreadPool& pool) {
+	MultiStartResult result;
+	result.cities.resize(CITY_COUNT);
+
+	std::unique_ptr<MultiStartWorker[]> workers(new MultiStartWorker[pool.GetThreadCount()]); // Too large for thread stacks
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	pool.ParallelFor(CITY_COUNT, [&](int startingCity, int workerIndex) {
+		MultiStartWorker& worker = workers[workerIndex];
+		MultiStartCityResult& cityResult = result.cities[startingCity];
+		std::chrono::steady_clock::time_point cityStart = std::chrono::steady_clock::now();
+
+		cityResult.startingCity = startingCity;
+		cityResult.worker = workerIndex;
+
+		for (int heuristic = 0; heuristic < MULTI_START_HEURISTIC_COUNT; ++heuristic) {
+			cityResult.lengths[heuristic] = RunMultiStartHeuristic(graph, worker, heuristic, startingCity);
+
+			if (heuristic == 0 || cityResult.lengths[heuristic] > cityResult.lengths[cityResult.bestHeuristic]) {
+				cityResult.bestHeuristic = heuristic;
+				cityResult.bestPath = worker.context.foundPath;
+			}
+		}
+
+		cityResult.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cityStart).count();
+	});
+
+	result.wallMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	for (int city = 0; city < CITY_COUNT; ++city) {
+		const MultiStartCityResult& cityResult = result.cities[city];
+		int length = cityResult.lengths[cityResult.bestHeuristic];
+
+		if (length > result.bestLength) {
+			result.bestCity = city;
+			result.bestHeuristic = cityResult.bestHeuristic;
+			result.bestLength = length;
+		}
+	}
+
+	return result;
+}
+
+// Prints the path lengths of every heuristic per starting city and the best path
+void PrintMultiStartReport(const MultiStartResult& result, int threadCount) {
+	std::cout << std::setw(6) << "City";
+	for (int heuristic = 0; heuristic < MULTI_START_HEURISTIC_COUNT; ++heuristic)
+		std::cout << std::setw(13) << GetMultiStartHeuristicName(heuristic);
+	std::cout << std::endl;
+
+	for (size_t i = 0; i < result.cities.size(); ++i) {
+		std::cout << std::setw(6) << result.cities[i].startingCity;
+		for (int heuristic = 0; heuristic < MULTI_START_HEURISTIC_COUNT; ++heuristic)
+			std::cout << std::setw(13) << result.cities[i].lengths[heuristic];
+		std::cout << std::endl;
+	}
+
+	std::cout << CITY_COUNT << " starting cities on " << threadCount << " threads in " << result.wallMilliseconds << " ms" << std::endl;
+	std::cout << "Best path is " << result.bestLength << " cities from city " << result.bestCity << " with "
+		<< GetMultiStartHeuristicName(result.bestHeuristic) << std::endl;
+
+	StaticVector<int, CITY_COUNT> bestPath = result.cities[result.bestCity].bestPath;
+	std::cout << bestPath;
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <Algorithms.h>
+#include <StaticVectorLibrary.h>
+#include <WorkStealingThreadPool.h>
+#include <IncrementalBandGraph.h>
+#include <HeuristicApproaches.cpp>
+
+// Range of the (distance, tolerance) grid, both are decreased by 1 like FindMinimumDistanceTolerance
+struct SweepGrid {
+	int maxDistance = 220;
+	int minDistance = 1;
+	int maxTolerance = 50;
+	int minTolerance = 1;
+	int startingCity = 5;
+
+	int ToleranceCount() const { return maxTolerance - minTolerance + 1; }
+	int DistanceCount() const { return maxDistance - minDistance + 1; }
+	int ConfigCount() const { return DistanceCount() * ToleranceCount(); }
+
+	// Configs are numbered in the order the sequential sweep visits them
+	int DistanceAt(int config) const { return maxDistance - config / ToleranceCount(); }
+	int ToleranceAt(int config) const { return maxTolerance - config % ToleranceCount(); }
+};
+
+struct SweepConfigResult {
+	int distance = 0;
+	int tolerance = 0;
+	int score = 0;
+	double milliseconds = 0;
+	int worker = -1;
+};
+
+struct SweepResult {
+	int bestDistance = 0;
+	int bestTolerance = 0;
+	int bestScore = 0;
+	double wallMilliseconds = 0;
+	std::vector<SweepConfigResult> configs; // Indexed like SweepGrid configs
+};
+
+// Buffers and combination scorer owned by one worker thread, nothing here is shared between threads
+struct SweepWorker {
+	StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT> graph;
+	bool visited[CITY_COUNT];
+	CombinationScorer scorer;
+};
+
+// Picks the best config in sweep order, ties go to the later config like the sequential sweep
+inline void ReduceSweepResult(SweepResult& result) {
+	result.bestScore = 0;
+	for (size_t i = 0; i < result.configs.size(); ++i) {
+		if (result.configs[i].score >= result.bestScore) {
+			result.bestDistance = result.configs[i].distance;
+			result.bestTolerance = result.configs[i].tolerance;
+			result.bestScore = result.configs[i].score;
+		}
+	}
+}
+
+// Parallel version of FindMinimumDistanceTolerance. Every config is independent so the grid is
+// distributed over the pool, each worker refills its own graph buffer instead of copying the matrix.
+// The result is the same as the sequential sweep for any thread count.
+SweepResult FindMinimumDistanceToleranceParallel(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& adjMatrix,
+	WorkStealingThreadPool& pool, const SweepGrid& grid = SweepGrid()) {
+
+	SweepResult result;
+	result.configs.resize(grid.ConfigCount());
+
+	std::unique_ptr<SweepWorker[]> workers(new SweepWorker[pool.GetThreadCount()]); // Too large for thread stacks
+
+	std::chrono::steady_clock::time_point sweepStart = std::chrono::steady_clock::now();
+
+	pool.ParallelFor(grid.ConfigCount(), [&](int config, int workerIndex) {
+		SweepWorker& worker = workers[workerIndex];
+		std::chrono::steady_clock::time_point configStart = std::chrono::steady_clock::now();
+
+		int distance = grid.DistanceAt(config);
+		int tolerance = grid.ToleranceAt(config);
+
+		CreateGraph(adjMatrix, worker.graph, distance, tolerance);
+
+		for (int i = 0; i < CITY_COUNT; ++i)
+			worker.visited[i] = false;
+
+		SweepConfigResult& configResult = result.configs[config];
+		configResult.distance = distance;
+		configResult.tolerance = tolerance;
+		configResult.score = FindLongestPathComposed(worker.graph, worker.visited, grid.startingCity, -1, worker.scorer);
+		configResult.worker = workerIndex;
+		configResult.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - configStart).count();
+	});
+
+	result.wallMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sweepStart).count();
+
+	ReduceSweepResult(result);
+
+	return result;
+}
+
+// Incremental version of the sweep. The city pairs are sorted by distance once, every worker keeps a band graph
+// and moves its band from config to config, so only the edges entering or leaving the band are touched instead of
+// filtering the whole matrix. A task is one distance row, tolerances in a row shrink the band by 1 km on each side.
+// The search starts from the bit rows of the band graph and removes the visited cities from the composer's copy of
+// the rows, the matrix isn't copied. Each config still prepares the composer, which copies the rows and clears the hop distances.
+SweepResult FindMinimumDistanceToleranceIncremental(StaticVector<StaticVector<int, CITY_COUNT>, CITY_COUNT>& adjMatrix,
+	WorkStealingThreadPool& pool, const SweepGrid& grid = SweepGrid()) {
+
+	SweepResult result;
+	result.configs.resize(grid.ConfigCount());
+
+	std::unique_ptr<SortedCityPairs<CITY_COUNT>> cityPairs(new SortedCityPairs<CITY_COUNT>());
+	cityPairs->Build(adjMatrix);
+
+	std::unique_ptr<SweepWorker[]> workers(new SweepWorker[pool.GetThreadCount()]);
+	std::vector<std::unique_ptr<IncrementalBandGraph<CITY_COUNT>>> bandGraphs;
+	for (int i = 0; i < pool.GetThreadCount(); ++i)
+		bandGraphs.emplace_back(new IncrementalBandGraph<CITY_COUNT>(*cityPairs));
+
+	std::chrono::steady_clock::time_point sweepStart = std::chrono::steady_clock::now();
+
+	pool.ParallelFor(grid.DistanceCount(), [&](int row, int workerIndex) {
+		SweepWorker& worker = workers[workerIndex];
+		IncrementalBandGraph<CITY_COUNT>& bandGraph = *bandGraphs[workerIndex];
+
+		for (int column = 0; column < grid.ToleranceCount(); ++column) {
+			int config = row * grid.ToleranceCount() + column;
+			std::chrono::steady_clock::time_point configStart = std::chrono::steady_clock::now();
+
+			int distance = grid.DistanceAt(config);
+			int tolerance = grid.ToleranceAt(config);
+
+			bandGraph.SetBand(distance - tolerance, distance + tolerance);
+
+			for (int i = 0; i < CITY_COUNT; ++i)
+				worker.visited[i] = false;
+
+			SweepConfigResult& configResult = result.configs[config];
+			configResult.distance = distance;
+			configResult.tolerance = tolerance;
+			configResult.score = FindLongestPathComposedMasked(bandGraph.GetAdjacency(), bandGraph.GetGraph(), worker.visited,
+				grid.startingCity, worker.scorer);
+			configResult.worker = workerIndex;
+			configResult.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - configStart).count();
+		}
+	});
+
+	result.wallMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sweepStart).count();
+
+	ReduceSweepResult(result);
+
+	return result;
+}
+
+// Prints the best config and the timing summary of the sweep
+void PrintSweepReport(const SweepResult& result, int threadCount) {
+	double totalMilliseconds = 0;
+	int slowestConfig = 0;
+
+	for (size_t i = 0; i < result.configs.size(); ++i) {
+		totalMilliseconds += result.configs[i].milliseconds;
+		if (result.configs[i].milliseconds > result.configs[slowestConfig].milliseconds)
+			slowestConfig = static_cast<int>(i);
+	}
+
+	std::cout << "OPTIMUM DISTANCE AND TOLERANCE: " << result.bestDistance << ", " << result.bestTolerance
+		<< " WITH CITY COUNT:" << result.bestScore << std::endl;
+
+	if (result.configs.empty())
+		return;
+
+	std::cout << result.configs.size() << " configs on " << threadCount << " threads in " << result.wallMilliseconds << " ms" << std::endl;
+	std::cout << "Mean config time is " << totalMilliseconds / result.configs.size() << " ms, sum of config times is "
+		<< totalMilliseconds << " ms" << std::endl;
+	std::cout << "Slowest config is (" << result.configs[slowestConfig].distance << ", " << result.configs[slowestConfig].tolerance
+		<< ") with " << result.configs[slowestConfig].milliseconds << " ms" << std::endl;
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <RuntimeGraph.h>
+#include <CsvDistanceLoader.h>
+#include <GraphCache.h>
+#include <StaticBitsetLibrary.h>
+#include <HeuristicApproaches.cpp>
+
+void PrintCsvErrors(const std::string& fileName, const CsvLoadResult& result) {
+	for (size_t i = 0; i < result.errors.size(); ++i)
+		std::cout << fileName << ":" << result.errors[i].line << ": " << result.errors[i].message << std::endl;
+}
+
+// Reads a distance table in the format of ilmesafe.csv, header lines then "plate;name;distances..." per city.
+// The city count is the number of rows, so tables of any size can be read without a rebuild.
+// pool can be NULL, large tables are parsed on its threads otherwise.
+bool ReadDistanceTable(const std::string& fileName, std::unique_ptr<RuntimeGraph>& graph, WorkStealingThreadPool* pool = NULL) {
+	CsvDistanceLoader loader(pool);
+	CsvLoadResult result = loader.Load(fileName, graph);
+
+	PrintCsvErrors(fileName, result);
+	return result.success;
+}
+
+// Same as ReadDistanceTable, but the table is taken from the binary cache when the cache was written from the same
+// CSV and has every band. Otherwise the CSV is parsed and the cache is written again with the bit rows of the bands.
+// While the CSV keeps the size and write time stored in the cache it isn't opened, otherwise it is hashed and a cache
+// of the same content only gets the new stamp. A graph from the cache reads its distances from the mapping.
+// The cache stays open so the bands can be loaded with cache.LoadBand. Not being able to write the cache isn't an error.
+bool ReadDistanceTableCached(const std::string& fileName, const std::string& cacheFileName, std::unique_ptr<RuntimeGraph>& graph,
+	GraphCache& cache, const std::vector<GraphCacheBand>& bands, WorkStealingThreadPool* pool = NULL) {
+
+	FileStamp stamp;
+	if (!GetFileStamp(fileName, stamp)) {
+		std::cout << "File is not open" << std::endl;
+		return false;
+	}
+
+	bool cacheUsable = cache.Open(cacheFileName);
+	for (size_t i = 0; i < bands.size() && cacheUsable; ++i)
+		cacheUsable = cache.HasBand(bands[i].low, bands[i].high);
+
+	if (cacheUsable && cache.HasSourceStamp(stamp))
+		return cache.Load(graph);
+
+	MappedFile source;
+	if (!source.Open(fileName)) {
+		std::cout << "File is not open" << std::endl;
+		return false;
+	}
+
+	uint64_t sourceHash = HashBytes(source.GetData(), source.GetSize());
+
+	bool sameSource = cacheUsable && cache.GetSourceHash() == sourceHash;
+	cache.Close(); // A mapped file can't be written on Windows
+
+	// Same CSV with another write time, only the stamp in the header changes
+	if (sameSource && GraphCache::WriteSourceStamp(cacheFileName, stamp) && cache.Open(cacheFileName))
+		return cache.Load(graph);
+
+	CsvDistanceLoader loader(pool);
+	CsvLoadResult result = loader.Load(source.GetData(), source.GetSize(), graph);
+
+	PrintCsvErrors(fileName, result);
+	if (!result.success)
+		return false;
+
+	if (GraphCache::Write(cacheFileName, *graph, sourceHash, stamp, bands))
+		cache.Open(cacheFileName);
+
+	return true;
+}
+
+// Combination of FindLongestPathComposed computed on the work rows of a runtime graph, for graphs larger than
+// the fixed sizes. Scores are the same as BasicCombinationScorer: -first + second + third order neighbors + closeness.
+class RuntimeCombinationScorer {
+public:
+	explicit RuntimeCombinationScorer(RuntimeGraph& runtimeGraph) : graph(runtimeGraph), wordCount(runtimeGraph.GetWordCount()),
+		seen(wordCount), frontier(wordCount), next(wordCount) {
+	}
+
+	// Same as zeroing the row and column of the city in the matrix
+	void RemoveVertex(int vertex) {
+		uint64_t* row = graph.WorkRow(vertex);
+
+		for (int w = 0; w < wordCount; ++w) {
+			for (uint64_t word = row[w]; word != 0; word &= word - 1) {
+				int neighbor = w * 64 + LowestSetBit(word);
+				graph.WorkRow(neighbor)[vertex / 64] &= ~(1ULL << (vertex % 64));
+			}
+			row[w] = 0;
+		}
+	}
+
+	double Score(int node, const uint64_t* visited) {
+		double total = 0;
+		total += -1.0 * FirstOrderScore(node, visited);
+		total += SecondOrderScore(node, visited);
+		total += ThirdOrderScore(node, visited);
+		total += ClosenessScore(node);
+		return total;
+	}
+
+private:
+	int UnvisitedDegree(int city, const uint64_t* visited) {
+		const uint64_t* row = graph.WorkRow(city);
+		int degree = 0;
+
+		for (int w = 0; w < wordCount; ++w)
+			degree += BitCount(row[w] & ~visited[w]);
+
+		return degree;
+	}
+
+	double FirstOrderScore(int node, const uint64_t* visited) {
+		double tempScore = UnvisitedDegree(node, visited);
+
+		return 1.0 - 1.0 / tempScore;
+	}
+
+	double SecondOrderScore(int node, const uint64_t* visited) {
+		if ((visited[node / 64] >> (node % 64)) & 1ULL)
+			return 0.0;
+
+		const uint64_t* row = graph.WorkRow(node);
+		double highestScore = 0;
+
+		for (int w = 0; w < wordCount; ++w) {
+			for (uint64_t word = row[w] & ~visited[w]; word != 0; word &= word - 1) {
+				int tempScore = UnvisitedDegree(w * 64 + LowestSetBit(word), visited);
+				if (tempScore > highestScore)
+					highestScore = tempScore;
+			}
+		}
+
+		return 1.0 - 1.0 / highestScore;
+	}
+
+	// Visits every neighbor of the neighbor, visited only filters the neighbor's neighbors
+	int ThirdOrderNeighborScore(int city, const uint64_t* visited) {
+		const uint64_t* row = graph.WorkRow(city);
+		int highestScore = 0;
+
+		for (int w = 0; w < wordCount; ++w) {
+			for (uint64_t word = row[w]; word != 0; word &= word - 1) {
+				int tempScore = UnvisitedDegree(w * 64 + LowestSetBit(word), visited);
+				if (tempScore > highestScore)
+					highestScore = tempScore;
+			}
+		}
+
+		return highestScore;
+	}
+
+	double ThirdOrderScore(int node, const uint64_t* visited) {
+		if ((visited[node / 64] >> (node % 64)) & 1ULL)
+			return 0.0;
+
+		const uint64_t* row = graph.WorkRow(node);
+		double highestScore = 0;
+
+		for (int w = 0; w < wordCount; ++w) {
+			for (uint64_t word = row[w] & ~visited[w]; word != 0; word &= word - 1) {
+				int tempScore = ThirdOrderNeighborScore(w * 64 + LowestSetBit(word), visited);
+				if (tempScore > highestScore)
+					highestScore = tempScore;
+			}
+		}
+
+		return 1.0 - 1.0 / highestScore;
+	}
+
+	// Sum of the hop distances with a level by level bit BFS, like HopDistanceTable
+	double ClosenessScore(int node) {
+		for (int w = 0; w < wordCount; ++w) {
+			seen[w] = 0;
+			frontier[w] = 0;
+		}
+		seen[node / 64] |= 1ULL << (node % 64);
+		frontier[node / 64] |= 1ULL << (node % 64);
+
+		int sum = 0;
+		int level = 0;
+		bool any = true;
+
+		while (any) {
+			level++;
+
+			for (int w = 0; w < wordCount; ++w)
+				next[w] = 0;
+
+			for (int w = 0; w < wordCount; ++w) {
+				for (uint64_t word = frontier[w]; word != 0; word &= word - 1) {
+					const uint64_t* row = graph.WorkRow(w * 64 + LowestSetBit(word));
+					for (int k = 0; k < wordCount; ++k)
+						next[k] |= row[k];
+				}
+			}
+
+			any = false;
+			for (int w = 0; w < wordCount; ++w) {
+				next[w] &= ~seen[w];
+				seen[w] |= next[w];
+				frontier[w] = next[w];
+				sum += level * BitCount(next[w]);
+				any = any || next[w] != 0;
+			}
+		}
+
+		return 1.0 / sum;
+	}
+
+	RuntimeGraph& graph;
+	int wordCount;
+	std::vector<uint64_t> seen;
+	std::vector<uint64_t> frontier;
+	std::vector<uint64_t> next;
+};
+
+// Same search as FindLongestPathComposed on the runtime graph, iterative so large graphs don't need deep recursion.
+// The path starts with the starting city, returns the city count of the path.
+int FindLongestPathRuntime(RuntimeGraph& graph, int startingCity, CityPath& path) {
+	int wordCount = graph.GetWordCount();
+	std::vector<uint64_t> visited(wordCount, 0);
+	RuntimeCombinationScorer scorer(graph);
+
+	graph.ResetWorkRows();
+	path.Clear();
+	path.PushBack(startingCity);
+
+	int currentCity = startingCity;
+	while (true) {
+		visited[currentCity / 64] |= 1ULL << (currentCity % 64);
+
+		double highestScore = 0;
+		int highestScoreIndex = -1;
+		const uint64_t* row = graph.WorkRow(currentCity);
+
+		for (int w = 0; w < wordCount; ++w) {
+			for (uint64_t word = row[w]; word != 0; word &= word - 1) {
+				int neighbor = w * 64 + LowestSetBit(word);
+				double tempScore = scorer.Score(neighbor, visited.data());
+
+				if (tempScore > highestScore) {
+					highestScore = tempScore;
+					highestScoreIndex = neighbor;
+				}
+			}
+		}
+
+		if (highestScoreIndex == -1)
+			break;
+
+		scorer.RemoveVertex(currentCity); // Blocking the previous city paths not to visit again
+		path.PushBack(highestScoreIndex);
+		currentCity = highestScoreIndex;
+	}
+
+	return path.GetSize();
+}
+
+// Copies the filtered graph into a fixed size matrix, the cities after the city count have no edges
+// so they don't change any score, and runs the compile time combination with the bit row fast paths
+template <unsigned int N>
+int FindLongestPathFixed(RuntimeGraph& graph, int startingCity, CityPath& path) {
+	int cityCount = graph.GetCityCount();
+
+	// Too large for the stack at N = 256
+	std::unique_ptr<StaticVector<StaticVector<int, N>, N>> fixedGraph(new StaticVector<StaticVector<int, N>, N>());
+	std::unique_ptr<StaticVector<int, N>> fixedPath(new StaticVector<int, N>());
+	std::unique_ptr<BasicCombinationScorer<N>> scorer(new BasicCombinationScorer<N>());
+	bool visited[N] = { false };
+
+	for (int i = 0; i < N; ++i) {
+		for (int j = 0; j < N; ++j)
+			(*fixedGraph)[i][j] = (i < cityCount && j < cityCount) ? graph.Edge(i, j) : 0;
+	}
+
+	int count = FindLongestPathComposed(*fixedGraph, visited, startingCity, -1, *scorer, fixedPath.get());
+
+	path.Clear();
+	path.PushBack(startingCity);
+	for (int i = 0; i < fixedPath->GetSize(); ++i)
+		path.PushBack((*fixedPath)[i]);
+
+	return count;
+}
+
+// Fixed size the dispatch uses for a city count, 0 if the runtime search is used
+inline int GetFixedGraphSize(int cityCount) {
+	if (cityCount <= 64)
+		return 64;
+	if (cityCount <= 128)
+		return 128;
+	if (cityCount <= 256)
+		return 256;
+
+	return 0;
+}
+
+// Runs the combination search on a filtered runtime graph, with the smallest fixed size the graph fits in
+int FindLongestPathDispatch(RuntimeGraph& graph, int startingCity, CityPath& path) {
+	switch (GetFixedGraphSize(graph.GetCityCount())) {
+	case 64:
+		return FindLongestPathFixed<64>(graph, startingCity, path);
+	case 128:
+		return FindLongestPathFixed<128>(graph, startingCity, path);
+	case 256:
+		return FindLongestPathFixed<256>(graph, startingCity, path);
+	default:
+		return FindLongestPathRuntime(graph, startingCity, path);
+	}
+}